@@ -0,0 +1,221 @@
+/************************************************************
+  DAG Executor  –  依存グラフ上のタスクを work-stealing で並列実行
+  ----------------------------------------------------------
+  ◆ できること (N = タスク数, M = 依存辺数)
+    - 前提タスクが全て終わった瞬間に実行可能 (段ごとのバリア無し)
+    - 実行可能タスクはワーカ毎の両端キューに積み、空いたワーカが盗む
+      (盗めるものも無いワーカは condition_variable で眠り、CPU を使わない)
+    - critical_first = true で「残りの最長経路が長い順」に優先実行
+    - タスク毎の開始/終了時刻・実行ワーカを返す
+    - 閉路検出時は 1 つも実行せず空 vector (topological_sort と同じ)
+
+  ◆ 主要関数
+      run_dag(g, task, threads = 0, critical_first = false, cost = {})
+        g    : 隣接リスト (g[v] に v→to : v の後に to を実行)
+        task : void(int v)
+        cost : critical_first 用の各タスクの見積り時間 (省略時すべて 1)
+        -> vector<DagTaskTime>  (閉路なら空)
+
+  ◆ 典型用法
+      auto tm = run_dag(g, [&](int v){ build(v); }, 8, true);
+      if (tm.empty()) { ... }            // 閉路
+      double makespan = 0;
+      for (auto &t : tm) makespan = max(makespan, t.end_ms);
+************************************************************/
+
+#pragma once
+#include <bits/stdc++.h>
+#define TOPOLOGICALSORT_NO_DEMO
+#include "TopologicalSort.cpp"
+using namespace std;
+
+struct DagTaskTime
+{
+  double start_ms = 0, end_ms = 0; // run_dag 呼び出し時刻からの経過 [ms]
+  int worker = -1;                 // 実行したワーカ番号
+};
+
+// タスクが例外を投げた場合は新規実行を止め、全ワーカ終了後に再送出する
+template <class F>
+vector<DagTaskTime> run_dag(const vector<vector<int>> &g, F &&task, int threads = 0,
+                            bool critical_first = false, const vector<double> &cost = {})
+{
+  const int N = (int)g.size();
+  assert(cost.empty() || (int)cost.size() == N);
+  vector<int> order = topological_sort(g);
+  if (N == 0 || order.empty())
+    return {}; // 閉路なら何も実行しない
+
+  vector<atomic<int>> indeg(N);
+  for (int v = 0; v < N; ++v)
+    for (int to : g[v])
+      indeg[to].fetch_add(1, memory_order_relaxed);
+
+  // prio[v] = v から終端までの最長経路 (v 自身を含む)
+  vector<double> prio;
+  if (critical_first)
+  {
+    prio.assign(N, 0);
+    for (int i = N - 1; i >= 0; --i)
+    {
+      int v = order[i];
+      double best = 0;
+      for (int to : g[v])
+        best = max(best, prio[to]);
+      prio[v] = best + (cost.empty() ? 1.0 : cost[v]);
+    }
+  }
+  auto lower = [&](int a, int b)
+  { return prio[a] < prio[b]; };
+
+  int T = threads > 0 ? threads : max(1, (int)thread::hardware_concurrency());
+  T = min(T, N);
+
+  // 通常: 自分は末尾 (LIFO) から取り、他人は先頭 (FIFO) から盗む
+  // 優先: prio の max-heap として扱い、自分も他人も最大を取る
+  struct WorkQueue
+  {
+    mutex m;
+    deque<int> dq;
+  };
+  vector<WorkQueue> qs(T);
+  // 仕事が無いワーカは idle_cv で待つ (queued = キューに積まれたタスク数)
+  atomic<int> queued{0};
+  mutex idle_m;
+  condition_variable idle_cv;
+  auto wake = [&](bool all)
+  {
+    { lock_guard<mutex> lk(idle_m); } // 待ちに入る途中のワーカを取りこぼさない
+    all ? idle_cv.notify_all() : idle_cv.notify_one();
+  };
+  auto push = [&](int w, int v)
+  {
+    {
+      lock_guard<mutex> lk(qs[w].m);
+      qs[w].dq.push_back(v);
+      if (critical_first)
+        push_heap(qs[w].dq.begin(), qs[w].dq.end(), lower);
+    }
+    queued.fetch_add(1, memory_order_release);
+  };
+  auto take = [&](int w, bool own) -> int
+  {
+    lock_guard<mutex> lk(qs[w].m);
+    auto &dq = qs[w].dq;
+    if (dq.empty())
+      return -1;
+    int v;
+    if (critical_first)
+    {
+      pop_heap(dq.begin(), dq.end(), lower);
+      v = dq.back();
+      dq.pop_back();
+    }
+    else if (own)
+    {
+      v = dq.back();
+      dq.pop_back();
+    }
+    else
+    {
+      v = dq.front();
+      dq.pop_front();
+    }
+    queued.fetch_sub(1, memory_order_relaxed);
+    return v;
+  };
+
+  for (int v = 0, k = 0; v < N; ++v)
+    if (indeg[v].load(memory_order_relaxed) == 0)
+      push(k++ % T, v);
+
+  vector<DagTaskTime> tm(N);
+  atomic<int> remaining{N};
+  atomic<bool> stop{false};
+  exception_ptr err;
+  mutex err_m;
+  const auto t0 = chrono::steady_clock::now();
+  auto elapsed = [&]()
+  { return chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count(); };
+
+  auto worker = [&](int w)
+  {
+    while (remaining.load(memory_order_acquire) > 0 && !stop.load(memory_order_relaxed))
+    {
+      int v = take(w, true);
+      for (int k = 1; v == -1 && k < T; ++k)
+        v = take((w + k) % T, false);
+      if (v == -1)
+      {
+        unique_lock<mutex> lk(idle_m);
+        idle_cv.wait(lk, [&]
+                     { return queued.load(memory_order_acquire) > 0 || remaining.load(memory_order_acquire) == 0 ||
+                              stop.load(memory_order_relaxed); });
+        continue;
+      }
+      tm[v].worker = w;
+      tm[v].start_ms = elapsed();
+      try
+      {
+        task(v);
+      }
+      catch (...)
+      {
+        lock_guard<mutex> lk(err_m);
+        if (!err)
+          err = current_exception();
+        stop.store(true);
+      }
+      tm[v].end_ms = elapsed();
+      int pushed = 0;
+      for (int to : g[v])
+        if (indeg[to].fetch_sub(1, memory_order_acq_rel) == 1)
+          push(w, to), ++pushed;
+      const bool last = remaining.fetch_sub(1, memory_order_release) == 1;
+      // 積んだ 1 つ目は自分で取るので、起こすのは 2 つ目以降の分だけ
+      if (last || stop.load(memory_order_relaxed) || pushed > 2)
+        wake(true);
+      else if (pushed == 2)
+        wake(false);
+    }
+  };
+
+  vector<thread> pool;
+  for (int w = 1; w < T; ++w)
+    pool.emplace_back(worker, w);
+  worker(0);
+  for (auto &th : pool)
+    th.join();
+  if (err)
+    rethrow_exception(err);
+  return tm;
+}
+
+int main()
+{
+  ios::sync_with_stdio(false);
+  cin.tie(nullptr);
+
+  int N, M;
+  cin >> N >> M;
+  vector<vector<int>> g(N);
+  for (int i = 0; i < M; ++i)
+  {
+    int u, v;
+    cin >> u >> v;
+    g[u].push_back(v);
+  }
+
+  auto tm = run_dag(
+      g, [&](int v)
+      { this_thread::sleep_for(chrono::milliseconds(10 * (v % 3 + 1))); },
+      4, true);
+  if (tm.empty())
+  {
+    cout << "Cycle detected\n";
+    return 0;
+  }
+  for (int v = 0; v < N; ++v)
+    cout << "task " << v << " : worker=" << tm[v].worker << fixed << setprecision(2)
+         << " start=" << tm[v].start_ms << "ms end=" << tm[v].end_ms << "ms\n";
+}
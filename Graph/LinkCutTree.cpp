@@ -0,0 +1,331 @@
+/************************************************************
+  Link-Cut Tree  –  動的森の辺追加・削除と経路集約を償却 O(log N)
+  ----------------------------------------------------------
+  ◆ できること (N = 頂点数)          | 時間計算量
+    - 一括構築 build(parent, pcost)  | O(N)
+    - 辺追加 link(u, v, w = id)      | 償却 O(log N)
+    - 辺削除 cut(u, v)               | 償却 O(log N)
+    - 根の付け替え evert(v)          | 償却 O(log N)
+    - 連結判定 connected(u, v)       | 償却 O(log N)
+    - 現在の根での LCA lca(u, v)     | 償却 O(log N)
+    - 経路集約 path_fold(u, v)       | 償却 O(log N)
+    - 頂点値 / 辺重みの更新          | 償却 O(log N)
+
+  ◆ 実装方針
+    * 辺 (u, v, w) を「辺ノード」e として u - e - v に細分化して保持する。
+      evert で向きが変わっても辺重みが正しい辺に残るため、
+      RootedTreeW の pcost をそのまま載せられる。
+    * 頂点 0..N-1、辺ノード N..2N-2 をすべて配列 (ch / par / rev / val / agg)
+      で持ち、ノード毎のヒープ確保はしない。
+    * Op は可換なモノイド演算 (plus / max など) を想定。
+
+  ◆ 典型用法
+      RootedTreeW tree(g, 0);
+      LinkCutTree<long long> lct(N);
+      lct.build(tree.parent, tree.pcost);   // O(N) で一括構築
+      lct.cut(u, tree.parent[u]);           // 辺を切る
+      lct.link(u, v, w);                    // 別の場所へ繋ぎ直す
+      long long d = lct.path_fold(a, b);    // a-b 間の辺重み総和
+      lct.evert(r);  int c = lct.lca(a, b); // 根 r での LCA
+************************************************************/
+
+#pragma once
+#include <bits/stdc++.h>
+using namespace std;
+
+template <class T = long long, class Op = plus<T>>
+struct LinkCutTree
+{
+  int N;
+  vector<array<int, 2>> ch; // splay 木の子 (無ければ -1)
+  vector<int> par, sz;      // splay 親 or 経路親 (-1 = なし), 部分木ノード数
+  vector<char> rev;         // 反転遅延フラグ
+  vector<T> val, agg;       // ノードの値, splay 部分木の集約値
+  vector<int> free_edge;    // 未使用の辺ノード
+  vector<int> stk;          // splay 用の作業領域
+  T id;
+  Op op;
+
+  explicit LinkCutTree(int n = 0, T id_ = T{}, Op op_ = Op{}) : id(id_), op(op_) { init(n); }
+
+  void init(int n)
+  {
+    N = n;
+    int tot = max(2 * N - 1, 0);
+    ch.assign(tot, {-1, -1});
+    par.assign(tot, -1);
+    sz.assign(tot, 1);
+    rev.assign(tot, 0);
+    val.assign(tot, id);
+    agg.assign(tot, id);
+    free_edge.clear();
+    for (int e = tot - 1; e >= N; --e)
+      free_edge.push_back(e);
+  }
+
+  // RootedTree / RootedTreeW の parent, pcost から森を O(N) で構築
+  //   pcost を省略すると辺重みはすべて id
+  template <class W = int>
+  void build(const vector<int> &parent, const vector<W> &pcost = {})
+  {
+    init((int)parent.size());
+    for (int v = 0; v < N; ++v)
+    {
+      if (parent[v] == -1)
+        continue;
+      int e = free_edge.back();
+      free_edge.pop_back();
+      val[e] = agg[e] = pcost.empty() ? id : T(pcost[v]);
+      par[v] = e; // 全ノードが単独の splay 木・経路親ポインタのみで繋ぐ
+      par[e] = parent[v];
+    }
+  }
+
+  // 頂点 v の値を x に (経路集約に含まれる。既定は id)
+  void set_vertex(int v, T x)
+  {
+    access(v);
+    val[v] = x;
+    update(v);
+  }
+
+  T get_vertex(int v) const { return val[v]; }
+
+  // 辺 (u, v) を重み id で追加 (T{} が単位元とは限らないので既定引数にしない)
+  bool link(int u, int v) { return link(u, v, id); }
+
+  // 辺 (u, v) を重み w で追加。既に連結なら何もせず false
+  bool link(int u, int v, T w)
+  {
+    if (connected(u, v))
+      return false;
+    int e = free_edge.back();
+    free_edge.pop_back();
+    val[e] = agg[e] = w;
+    sz[e] = 1;
+    evert(u);
+    par[u] = e;
+    par[e] = v;
+    return true;
+  }
+
+  // 辺 (u, v) を削除。辺が無ければ false
+  bool cut(int u, int v)
+  {
+    int e = find_edge(u, v);
+    if (e == -1)
+      return false;
+    // find_edge 後: v が splay 根で、左部分木 = {u, e}
+    int l = ch[v][0];
+    ch[v][0] = -1;
+    par[l] = -1;
+    update(v);
+    splay(e); // u が根なので e の左子が u
+    par[ch[e][0]] = -1;
+    ch[e][0] = -1;
+    update(e);
+    val[e] = agg[e] = id;
+    free_edge.push_back(e);
+    return true;
+  }
+
+  // 辺 (u, v) の重みを w に。辺が無ければ false
+  bool set_edge(int u, int v, T w)
+  {
+    int e = find_edge(u, v);
+    if (e == -1)
+      return false;
+    splay(e);
+    val[e] = w;
+    update(e);
+    return true;
+  }
+
+  // v を属する木の根にする
+  void evert(int v)
+  {
+    access(v);
+    toggle(v);
+  }
+
+  // v が属する木の現在の根
+  int root(int v)
+  {
+    access(v);
+    for (push(v); ch[v][0] != -1; push(v))
+      v = ch[v][0];
+    splay(v);
+    return v;
+  }
+
+  bool connected(int u, int v) { return u == v || root(u) == root(v); }
+
+  // 現在の根での LCA (非連結なら -1)
+  int lca(int u, int v)
+  {
+    if (!connected(u, v))
+      return -1;
+    access(u);
+    return access(v);
+  }
+
+  // u-v 経路上の頂点値・辺重みの集約 (連結であること)
+  T path_fold(int u, int v)
+  {
+    evert(u);
+    access(v);
+    return agg[v];
+  }
+
+  // 根から v までの経路を優先パスにし、v を splay 根にする
+  //   返り値: 最後に経路が切り替わったノード (lca 用)
+  int access(int x)
+  {
+    int last = -1;
+    for (int y = x; y != -1; y = par[y])
+    {
+      splay(y);
+      ch[y][1] = last;
+      update(y);
+      last = y;
+    }
+    splay(x);
+    return last;
+  }
+
+private:
+  bool is_root(int x) const
+  {
+    int p = par[x];
+    return p == -1 || (ch[p][0] != x && ch[p][1] != x);
+  }
+
+  void update(int x)
+  {
+    auto [l, r] = ch[x];
+    T a = val[x];
+    int s = 1;
+    if (l != -1)
+      a = op(agg[l], a), s += sz[l];
+    if (r != -1)
+      a = op(a, agg[r]), s += sz[r];
+    agg[x] = a;
+    sz[x] = s;
+  }
+
+  void toggle(int x)
+  {
+    swap(ch[x][0], ch[x][1]);
+    rev[x] ^= 1;
+  }
+
+  void push(int x)
+  {
+    if (!rev[x])
+      return;
+    for (int c : ch[x])
+      if (c != -1)
+        toggle(c);
+    rev[x] = 0;
+  }
+
+  void rotate(int x)
+  {
+    int p = par[x], g = par[p];
+    int d = (ch[p][1] == x);
+    int b = ch[x][d ^ 1];
+    if (!is_root(p))
+      ch[g][ch[g][1] == p] = x;
+    par[x] = g;
+    ch[x][d ^ 1] = p;
+    par[p] = x;
+    ch[p][d] = b;
+    if (b != -1)
+      par[b] = p;
+    update(p);
+    update(x);
+  }
+
+  void splay(int x)
+  {
+    stk.clear();
+    for (int y = x;; y = par[y])
+    {
+      stk.push_back(y);
+      if (is_root(y))
+        break;
+    }
+    for (int i = (int)stk.size() - 1; i >= 0; --i)
+      push(stk[i]);
+    while (!is_root(x))
+    {
+      int p = par[x];
+      if (!is_root(p))
+        rotate((ch[p][1] == x) == (ch[par[p]][1] == p) ? p : x);
+      rotate(x);
+    }
+  }
+
+  // 辺 (u, v) の辺ノード (無ければ -1)
+  //   成功時は u が根、v が splay 根で左部分木が {u, e} の状態で返る
+  int find_edge(int u, int v)
+  {
+    if (u == v || !connected(u, v))
+      return -1;
+    evert(u);
+    access(v);
+    int l = ch[v][0];
+    if (sz[l] != 2)
+      return -1; // 隣接していない
+    push(l);
+    int e = ch[l][1] != -1 ? ch[l][1] : l;
+    return e >= N ? e : -1;
+  }
+};
+
+int main()
+{
+  ios::sync_with_stdio(false);
+  cin.tie(nullptr);
+
+  // RootedTreeW の parent / pcost をそのまま渡せる
+  //        0
+  //      3/ \5
+  //      1   2
+  //     1|
+  //      3
+  vector<int> parent = {-1, 0, 0, 1}, pcost = {0, 3, 5, 1};
+  LinkCutTree<long long> lct;
+  lct.build(parent, pcost);
+  cout << lct.path_fold(3, 2) << '\n'; // 1 + 3 + 5 = 9
+  lct.evert(0);
+  cout << lct.lca(3, 2) << '\n'; // 0
+
+  int N, Q;
+  cin >> N >> Q;
+  LinkCutTree<long long> f(N);
+  while (Q--)
+  {
+    int t, u, v;
+    cin >> t >> u >> v;
+    if (t == 0)
+    { // 辺追加
+      long long w;
+      cin >> w;
+      f.link(u, v, w);
+    }
+    else if (t == 1)
+    { // 辺削除
+      f.cut(u, v);
+    }
+    else if (t == 2)
+    { // 経路重み和 (非連結なら -1)
+      cout << (f.connected(u, v) ? f.path_fold(u, v) : -1) << '\n';
+    }
+    else
+    { // 根 0 での LCA
+      f.evert(0);
+      cout << f.lca(u, v) << '\n';
+    }
+  }
+}
@@ -0,0 +1,153 @@
+/************************************************************
+  SCC (Strongly Connected Components)  –  非再帰 Tarjan + 縮約 DAG
+  ----------------------------------------------------------
+  ◆ できること (N = 頂点数, M = 辺数)      | 時間計算量
+    - 強連結成分分解 comp[v]              | O(N + M)
+    - 成分ごとの頂点列 (CSR)              | O(N)
+    - 縮約 DAG (CSR, 多重辺除去済み)      | O(N + M)
+    - 縮約 DAG のトポロジカル順           | O(1)  ※成分番号がそのまま順序
+    ※ 明示スタックで DFS するので 10^8 辺でも再帰の深さ制限に掛からない
+
+  ◆ 主要関数
+      scc_condense(g) -> SCCResult
+        g : 隣接リスト (g[v] に v→to を列挙) ※ topological_sort と同じ
+
+  ◆ 典型用法
+      auto r = scc_condense(g);
+      bool acyclic = r.num == N;              // 各頂点が単独成分 …
+      for (int v = 0; v < N; ++v)             // … でも自己ループ v→v は閉路
+          for (int to : g[v]) acyclic &= to != v;
+      for (int c : r.order)                   // 縮約 DAG をトポロジカル順に
+          for (int i = r.dag_start[c]; i < r.dag_start[c + 1]; ++i)
+              dp[r.dag_to[i]] = max(dp[r.dag_to[i]], dp[c] + w[c]);
+************************************************************/
+
+#pragma once
+#include <bits/stdc++.h>
+using namespace std;
+
+struct SCCResult
+{
+  int num = 0;                      // 成分数 C
+  vector<int> comp;                 // comp[v] : v の成分番号 (0..C-1, トポロジカル順)
+  vector<int> member_start, member; // member[member_start[c] .. member_start[c+1]) : 成分 c の頂点
+  vector<int> dag_start, dag_to;    // 縮約 DAG の辺 c→dag_to[i] (i ∈ [dag_start[c], dag_start[c+1]))
+  vector<int> order;                // 縮約 DAG のトポロジカル順 (= 0, 1, ..., C-1)
+};
+
+SCCResult scc_condense(const vector<vector<int>> &g)
+{
+  const int N = (int)g.size();
+  SCCResult res;
+  auto &comp = res.comp;
+  comp.assign(N, -1);
+  vector<int> idx(N, -1), low(N), it(N, 0), st, cs;
+  st.reserve(N);
+  int counter = 0, found = 0;
+
+  for (int s = 0; s < N; ++s)
+  {
+    if (idx[s] != -1)
+      continue;
+    idx[s] = low[s] = counter++;
+    st.push_back(s);
+    cs.push_back(s);
+    while (!cs.empty())
+    {
+      int v = cs.back();
+      if (it[v] < (int)g[v].size())
+      {
+        int to = g[v][it[v]++];
+        if (idx[to] == -1)
+        { // 子へ潜る
+          idx[to] = low[to] = counter++;
+          st.push_back(to);
+          cs.push_back(to);
+        }
+        else if (comp[to] == -1)
+        { // スタック上 (同じ成分の候補)
+          low[v] = min(low[v], idx[to]);
+        }
+        continue;
+      }
+      cs.pop_back(); // 帰りがけ
+      if (!cs.empty())
+        low[cs.back()] = min(low[cs.back()], low[v]);
+      if (low[v] == idx[v])
+      { // v が成分の根: シンク側の成分から順に確定する
+        int x;
+        do
+        {
+          x = st.back();
+          st.pop_back();
+          comp[x] = found;
+        } while (x != v);
+        ++found;
+      }
+    }
+  }
+
+  // Tarjan は逆トポロジカル順に成分を見つけるので番号を反転
+  const int C = res.num = found;
+  auto &ms = res.member_start;
+  ms.assign(C + 1, 0);
+  for (int v = 0; v < N; ++v)
+  {
+    comp[v] = C - 1 - comp[v];
+    ++ms[comp[v] + 1];
+  }
+  for (int c = 0; c < C; ++c)
+    ms[c + 1] += ms[c];
+  res.member.resize(N);
+  vector<int> fill_pos(ms.begin(), ms.end() - 1);
+  for (int v = 0; v < N; ++v)
+    res.member[fill_pos[comp[v]]++] = v;
+
+  // 縮約 DAG: 成分順に辺を並べるだけで CSR になる (last で多重辺を除去)
+  vector<int> last(C, -1);
+  res.dag_start.assign(C + 1, 0);
+  for (int c = 0; c < C; ++c)
+  {
+    for (int i = ms[c]; i < ms[c + 1]; ++i)
+      for (int to : g[res.member[i]])
+      {
+        int d = comp[to];
+        if (d != c && last[d] != c)
+        {
+          last[d] = c;
+          res.dag_to.push_back(d);
+        }
+      }
+    res.dag_start[c + 1] = (int)res.dag_to.size();
+  }
+
+  res.order.resize(C);
+  iota(res.order.begin(), res.order.end(), 0);
+  return res;
+}
+
+int main()
+{
+  ios::sync_with_stdio(false);
+  cin.tie(nullptr);
+
+  int N, M;
+  cin >> N >> M;
+  vector<vector<int>> g(N);
+  for (int i = 0; i < M; ++i)
+  {
+    int u, v;
+    cin >> u >> v;
+    g[u].push_back(v);
+  }
+
+  auto r = scc_condense(g);
+  cout << r.num << '\n';
+  for (int c : r.order)
+  {
+    cout << r.member_start[c + 1] - r.member_start[c];
+    for (int i = r.member_start[c]; i < r.member_start[c + 1]; ++i)
+      cout << ' ' << r.member[i];
+    cout << '\n';
+  }
+}
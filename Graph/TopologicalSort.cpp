@@ -1,3 +1,4 @@
+#pragma once
 #include <bits/stdc++.h>
 using namespace std;
 
@@ -41,3 +42,187 @@ vector<int> topological_sort(const vector<vector<int>> &g)
     }
     return (int)order.size() == N ? order : vector<int>(); // 閉路なら空を返す
 }
+
+// トポロジカル順の段 (wavefront) 分解 (CSR 形式)
+//   order[start[k] .. start[k+1]) が第 k 段。同じ段の頂点は互いに依存せず、
+//   前提となる頂点はすべて第 0..k-1 段に含まれる (= 同時に実行してよい)
+struct TopoLevels
+{
+    vector<int> start; // size = 段数 + 1 (閉路なら空)
+    vector<int> order; // size = N      (閉路なら空)
+    int levels() const { return max((int)start.size() - 1, 0); }
+};
+
+// 段ごとの同期用バリア (C++17 には std::barrier が無いので mutex + condition_variable で)
+//   最後に到着したスレッドが on_last() を実行してから全員を起こす
+struct LevelBarrier
+{
+    explicit LevelBarrier(int T) : T(T) {}
+
+    template <class F>
+    void arrive_and_wait(F &&on_last)
+    {
+        unique_lock<mutex> lk(m);
+        if (++arrived == T)
+        {
+            on_last();
+            arrived = 0;
+            ++phase;
+            cv.notify_all();
+            return;
+        }
+        const unsigned my = phase;
+        cv.wait(lk, [&]
+                { return phase != my; });
+    }
+
+private:
+    mutex m;
+    condition_variable cv;
+    const int T;
+    int arrived = 0;
+    unsigned phase = 0;
+};
+
+// g: 隣接リスト (g[v] に v→to を列挙)
+// threads: 使用スレッド数 (0 なら hardware_concurrency)
+// 戻り値: 段分解 (閉路検出で start, order ともに空)
+//   * 入次数計算・各段の処理を threads 本で分担し、入次数は atomic に減算する
+//   * 段内の並びはスレッド数 > 1 だと実行毎に変わりうる
+TopoLevels topological_levels_parallel(const vector<vector<int>> &g, int threads = 0)
+{
+    const int N = (int)g.size();
+    const int CHUNK = 1024; // 1 回に取る frontier 頂点数
+    int T = threads > 0 ? threads : max(1, (int)thread::hardware_concurrency());
+    T = max(1, min(T, N / CHUNK)); // 小さいグラフでは無理に分けない
+
+    vector<atomic<int>> indeg(N);
+    TopoLevels res;
+    res.order.resize(N);
+    res.start.assign(N + 1, 0); // 段数 <= N なので先に確保し、添字で書く
+    atomic<int> tail{0}, cursor{0};
+    int lvl_end = 0, lv = 0;
+    bool done = false;
+
+    // 全スレッドが段を処理し終えたら最後の 1 スレッドが次の段を確定させる
+    auto next_level = [&]
+    {
+        if (tail.load() == lvl_end)
+        {
+            done = true;
+            return;
+        }
+        cursor.store(lvl_end);
+        lvl_end = tail.load();
+        res.start[++lv] = lvl_end;
+    };
+    LevelBarrier sync(T);
+
+    auto worker = [&](int t)
+    {
+        int lo = (int)((long long)N * t / T), hi = (int)((long long)N * (t + 1) / T);
+        vector<int> local;
+        auto flush = [&]()
+        {
+            int pos = tail.fetch_add((int)local.size());
+            copy(local.begin(), local.end(), res.order.begin() + pos);
+            local.clear();
+        };
+
+        for (int v = lo; v < hi; ++v)
+            for (int to : g[v])
+                indeg[to].fetch_add(1, memory_order_relaxed);
+        sync.arrive_and_wait([] {}); // 入次数計算の完了
+
+        for (int v = lo; v < hi; ++v)
+            if (indeg[v].load(memory_order_relaxed) == 0)
+                local.push_back(v);
+        flush();
+        sync.arrive_and_wait(next_level); // 第 0 段が確定
+
+        while (!done)
+        {
+            for (int b; (b = cursor.fetch_add(CHUNK)) < lvl_end;)
+            {
+                for (int i = b, e = min(b + CHUNK, lvl_end); i < e; ++i)
+                    for (int to : g[res.order[i]])
+                        if (indeg[to].fetch_sub(1, memory_order_relaxed) == 1)
+                            local.push_back(to);
+                flush();
+            }
+            sync.arrive_and_wait(next_level);
+        }
+    };
+
+    vector<thread> pool;
+    for (int t = 1; t < T; ++t)
+        pool.emplace_back(worker, t);
+    worker(0);
+    for (auto &th : pool)
+        th.join();
+
+    if (tail.load() != N)
+        return {}; // 閉路なら空を返す
+    res.start.resize(lv + 1);
+    return res;
+}
+
+/*--------------------- demo ---------------------*/
+// ランダム DAG で topological_levels_parallel を逐次版 topological_sort と突き合わせる
+//   - 全頂点をちょうど 1 回ずつ含むこと
+//   - 各辺 v→to について to の段 > v の段
+//   - 段数 = 最長経路の頂点数 (逐次順で DP した値)
+//   - 閉路を足すとどちらも空
+#ifndef TOPOLOGICALSORT_NO_DEMO
+int main(int argc, char **argv)
+{
+    const int N = argc >= 2 ? atoi(argv[1]) : 200000, M = 4 * N;
+    mt19937 rng(1);
+    vector<int> perm(N);
+    iota(perm.begin(), perm.end(), 0);
+    shuffle(perm.begin(), perm.end(), rng);
+    vector<vector<int>> g(N);
+    for (int i = 0; i < M; ++i)
+    {
+        int a = rng() % N, b = rng() % N;
+        if (a != b)
+            g[perm[min(a, b)]].push_back(perm[max(a, b)]);
+    }
+
+    using clk = chrono::steady_clock;
+    auto t0 = clk::now();
+    vector<int> order = topological_sort(g);
+    auto t1 = clk::now();
+    TopoLevels lv = topological_levels_parallel(g, 8);
+    auto t2 = clk::now();
+
+    vector<int> depth(N, 0), level(N, -1);
+    for (int v : order)
+        for (int to : g[v])
+            depth[to] = max(depth[to], depth[v] + 1);
+    bool ok = (int)lv.order.size() == N && lv.start.front() == 0 && lv.start.back() == N;
+    for (int k = 0; ok && k < lv.levels(); ++k)
+        for (int i = lv.start[k]; i < lv.start[k + 1]; ++i)
+        {
+            ok &= level[lv.order[i]] == -1;
+            level[lv.order[i]] = k;
+        }
+    for (int v = 0; ok && v < N; ++v)
+        for (int to : g[v])
+            ok &= level[v] < level[to];
+    ok &= lv.levels() == *max_element(depth.begin(), depth.end()) + 1;
+
+    for (int v = 0; v < N; ++v)
+        if (!g[v].empty())
+        {
+            g[g[v][0]].push_back(v); // 逆辺を足して閉路にする
+            break;
+        }
+    ok &= topological_sort(g).empty() && topological_levels_parallel(g, 8).start.empty();
+
+    auto ms = [](auto d)
+    { return chrono::duration<double, milli>(d).count(); };
+    cout << "N=" << N << " levels=" << lv.levels() << "  serial " << ms(t1 - t0) << " ms  parallel " << ms(t2 - t1)
+         << " ms  " << (ok ? "OK" : "MISMATCH") << '\n';
+}
+#endif
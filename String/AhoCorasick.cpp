@@ -0,0 +1,198 @@
+/************************************************************
+  Aho–Corasick  –  複数パターンの一括検索 (Trie のノード配列を再利用)
+  ----------------------------------------------------------
+  ◆ できること (N = |T|, K = パターン数, L = Σ|P|, σ = 26)
+    - パターン登録 add(p) -> id        | O(|p|)  ※p は非空
+    - オートマトン構築 build()         | O(L σ)
+    - 全出現列挙 match(T, f)           | O(N + 出現数)
+    - 出現総数 count(T)                | O(N)
+    - パターン毎の出現回数 count_each  | O(N + L)
+
+  ◆ 実装方針
+    * トライ部分は Trie::tr (vector<Node>) をそのまま使う。
+      contains / prefix_count なども引き続き使える。
+    * go[v*σ + c] に完全な遷移表を前計算し、検索は 1 文字 1 参照。
+      Node::next は書き換えないので Trie としての意味は壊れない。
+    * fail : 失敗リンク, dict : 出力を持つ最寄りの真の接尾辞ノード
+      (match はこれを辿ってヒットだけを列挙する)
+    * 'a'-'z' 以外のテキスト文字は根に戻る区切りとして扱う
+
+  ◆ 典型用法
+      AhoCorasick ac;
+      for (auto &p : block) ac.add(p);   // id は 0, 1, 2, ...
+      ac.build();
+      ac.match(T, [&](int pos, int id){ ... });  // T[pos, pos+|P_id|) に出現
+      long long hits = ac.count(T);
+************************************************************/
+
+#pragma once
+#include <bits/stdc++.h>
+#define TRIE_NO_DEMO
+#include "Trie.cpp"
+using namespace std;
+
+struct AhoCorasick : Trie
+{
+  vector<int> go;                 // go[v*ALPHA + c] : 完全遷移表
+  vector<int> fail, dict;         // 失敗リンク, 辞書接尾辞リンク (-1 = なし)
+  vector<int> out_head, out_next; // ノード → 終端パターン id の連結リスト
+  vector<int> plen;               // plen[id] : パターン長
+  vector<long long> out_cnt;      // ノードで終わる (接尾辞含む) パターン数
+
+  // パターンを登録して id を返す (build 前に呼ぶ, p は非空)
+  int add(const string &p)
+  {
+    assert(!p.empty()); // 根が終端だと match / count / count_each の数え方が食い違う
+    int v = insert(p), id = (int)plen.size();
+    out_head.resize(tr.size(), -1);
+    out_next.push_back(out_head[v]);
+    out_head[v] = id;
+    plen.push_back((int)p.size());
+    return id;
+  }
+
+  // BFS 順に fail / dict / go / out_cnt を確定させる
+  void build()
+  {
+    const int n = (int)tr.size();
+    out_head.resize(n, -1);
+    go.assign((size_t)n * ALPHA, 0);
+    fail.assign(n, 0);
+    dict.assign(n, -1);
+    out_cnt.assign(n, 0);
+    bfs.clear();
+    bfs.push_back(0);
+    for (size_t h = 0; h < bfs.size(); ++h)
+    {
+      int v = bfs[h];
+      for (int id = out_head[v]; id != -1; id = out_next[id])
+        ++out_cnt[v];
+      if (v != 0)
+        out_cnt[v] += out_cnt[fail[v]];
+      for (int c = 0; c < ALPHA; ++c)
+      {
+        int u = tr[v].next[c];
+        if (u == -1)
+        {
+          go[(size_t)v * ALPHA + c] = v == 0 ? 0 : go[(size_t)fail[v] * ALPHA + c];
+          continue;
+        }
+        go[(size_t)v * ALPHA + c] = u;
+        int f = v == 0 ? 0 : go[(size_t)fail[v] * ALPHA + c];
+        fail[u] = f;
+        dict[u] = out_head[f] != -1 ? f : dict[f];
+        bfs.push_back(u);
+      }
+    }
+  }
+
+  // 状態 v から文字 ch で遷移
+  inline int step(int v, char ch) const
+  {
+    unsigned c = (unsigned)idx(ch);
+    return c < (unsigned)ALPHA ? go[(size_t)v * ALPHA + c] : 0;
+  }
+
+  // 各出現 (開始位置, パターン id) ごとに f(pos, id) を呼ぶ
+  template <class F>
+  void match(const string &text, F f) const
+  {
+    int v = 0;
+    for (int i = 0; i < (int)text.size(); ++i)
+    {
+      v = step(v, text[i]);
+      for (int u = out_head[v] != -1 ? v : dict[v]; u != -1; u = dict[u])
+        for (int id = out_head[u]; id != -1; id = out_next[id])
+          f(i - plen[id] + 1, id);
+    }
+  }
+
+  // 出現総数のみ (列挙しない)
+  long long count(const string &text) const
+  {
+    long long res = 0;
+    int v = 0;
+    for (char ch : text)
+    {
+      v = step(v, ch);
+      res += out_cnt[v];
+    }
+    return res;
+  }
+
+  // パターン id 毎の出現回数 (訪問回数を fail 木で葉から根へ集約)
+  vector<long long> count_each(const string &text) const
+  {
+    vector<long long> visit(tr.size(), 0), res(plen.size(), 0);
+    int v = 0;
+    for (char ch : text)
+      ++visit[v = step(v, ch)];
+    for (int h = (int)bfs.size() - 1; h > 0; --h)
+    {
+      int u = bfs[h];
+      visit[fail[u]] += visit[u];
+      for (int id = out_head[u]; id != -1; id = out_next[id])
+        res[id] = visit[u];
+    }
+    return res;
+  }
+
+private:
+  vector<int> bfs; // BFS 順 (count_each で逆順に使う)
+};
+
+/*--------------------- benchmark / demo ---------------------*/
+// K 本のパターンについて
+//   (a) AhoCorasick::count   (1 パス)
+//   (b) kmp_search をパターン毎に K 回
+// の時間を比較する。
+#ifndef AHOCORASICK_NO_DEMO
+#define KMP_NO_DEMO
+#include "KMP.cpp"
+int main()
+{
+  ios::sync_with_stdio(false);
+  cin.tie(nullptr);
+
+  const int N = 1 << 18, K = 1000;
+  mt19937 rng(1);
+  auto rnd_str = [&](int len, int sigma)
+  {
+    string s(len, 'a');
+    for (auto &c : s)
+      c = char('a' + rng() % sigma);
+    return s;
+  };
+  string T = rnd_str(N, 4);
+  vector<string> P(K);
+  for (auto &p : P)
+    p = rnd_str(4 + rng() % 12, 4);
+
+  using clk = chrono::steady_clock;
+  auto ms = [](auto d)
+  { return chrono::duration<double, milli>(d).count(); };
+
+  auto t0 = clk::now();
+  AhoCorasick ac;
+  for (auto &p : P)
+    ac.add(p);
+  ac.build();
+  auto t1 = clk::now();
+  long long c1 = ac.count(T);
+  auto t2 = clk::now();
+  long long c2 = 0;
+  ac.match(T, [&](int, int)
+           { ++c2; });
+  auto t3 = clk::now();
+  long long c3 = 0;
+  for (auto &p : P)
+    c3 += (long long)kmp_search(T, p).size();
+  auto t4 = clk::now();
+
+  cout << "N=" << N << " K=" << K << " hits=" << c1 << " (match " << c2 << ", kmp " << c3 << ")\n";
+  cout << "aho build : " << ms(t1 - t0) << " ms\n";
+  cout << "aho count : " << ms(t2 - t1) << " ms\n";
+  cout << "aho match : " << ms(t3 - t2) << " ms\n";
+  cout << "kmp x K   : " << ms(t4 - t3) << " ms\n";
+}
+#endif
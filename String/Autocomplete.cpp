@@ -0,0 +1,223 @@
+/************************************************************
+  Autocomplete Trie  –  重み付き語の接頭辞補完 (上位 k 件) を Trie 上で
+  ----------------------------------------------------------
+  ◆ できること (L = 語長, σ = 26)
+    - 重み付き挿入 insert(s, w)               | O(L σ) 最悪, 通常 O(L)
+    - 上位 k 件 top_k(p, k)                   | O(|p| + k L log(k L))
+    - 辞書順の逐次列挙 Trie::Cursor (継承)     | 1 語あたり償却 O(L)
+
+  ◆ 実装方針
+    * トライ部分は Trie::tr をそのまま使い (AhoCorasick と同じ)、
+      補完用の情報はノード番号で引く別配列に持つ。
+        wt[v]   : v で終わる語の重み (同じ語を入れると加算)
+        best[v] : v の部分木にある語の最大重み
+        ord[v]  : v の子を best の降順 (同点は文字順) に並べた文字列
+        par[v], pch[v] : 親と辺の文字 (語の復元用)
+    * 重みは増えるだけなので、挿入時は経路を下から上へ best を更新し、
+      親の ord の中で 1 つずつ前へ詰めるだけでよい。
+    * top_k は「語」と「兄弟列の i 番目以降」を要素とする best-first 探索。
+      兄弟列を取り出したら次の兄弟 1 つと自分の子列の先頭だけを積むので、
+      触るノードは O(k L) (部分木全体は見ない)。
+    * 同じ重みの語どうしの順序は決めていない。
+
+  ◆ 典型用法
+      AutocompleteTrie ac;
+      for (auto &[w, freq] : log) ac.insert(w, freq);
+      for (auto &[word, score] : ac.top_k("pro", 10)) ...
+      for (Trie::Cursor it(ac, "pro"); it.next();) ...   // 辞書順
+************************************************************/
+
+#pragma once
+#include <bits/stdc++.h>
+#define TRIE_NO_DEMO
+#include "Trie.cpp"
+using namespace std;
+
+struct AutocompleteTrie : Trie
+{
+  vector<long long> wt, best;
+  vector<array<uint8_t, ALPHA>> ord; // 子の文字 (best 降順)
+  vector<uint8_t> deg;               // 子の数
+  vector<int> par;
+  vector<uint8_t> pch;
+
+  AutocompleteTrie() { grow(); }
+
+  // 語 s の重みに w (>= 0) を足す。返り値は終端ノード番号
+  int insert(const string &s, long long w = 1)
+  {
+    assert(w >= 0);
+    const int old = (int)tr.size();
+    const int t = Trie::insert(s);
+    grow();
+    int v = 0;
+    for (char ch : s)
+    { // 新しく出来たノードを親の子列の末尾に足す
+      const int c = idx(ch), u = tr[v].next[c];
+      if (u >= old)
+      {
+        par[u] = v;
+        pch[u] = (uint8_t)c;
+        ord[v][deg[v]++] = (uint8_t)c;
+      }
+      v = u;
+    }
+    wt[t] += w;
+    for (int u = t; u != 0; u = par[u])
+    {
+      best[u] = max(best[u], wt[t]);
+      raise(par[u], pch[u]);
+    }
+    best[0] = max(best[0], wt[t]);
+    return t;
+  }
+
+  // 接頭辞 p を持つ語のうち重みの大きい順に k 件 {語, 重み}
+  vector<pair<string, long long>> top_k(const string &p, int k) const
+  {
+    vector<pair<string, long long>> res;
+    int v = 0;
+    for (char ch : p)
+      if ((v = child(v, ch)) == -1)
+        return res;
+    // 要素 : i == WORD なら語 node、それ以外は node の子列の i 番目以降
+    struct Item
+    {
+      long long key;
+      int node, i;
+      bool operator<(const Item &o) const { return key < o.key; }
+    };
+    constexpr int WORD = -1;
+    vector<Item> pq;
+    pq.reserve(3 * (size_t)k + 2);
+    auto expand = [&](int u)
+    {
+      if (tr[u].term)
+        pq.push_back({wt[u], u, WORD}), push_heap(pq.begin(), pq.end());
+      if (deg[u])
+        pq.push_back({best[tr[u].next[ord[u][0]]], u, 0}), push_heap(pq.begin(), pq.end());
+    };
+    expand(v);
+    while (!pq.empty() && (int)res.size() < k)
+    {
+      pop_heap(pq.begin(), pq.end());
+      const Item it = pq.back();
+      pq.pop_back();
+      if (it.i == WORD)
+      {
+        res.emplace_back(p + suffix(it.node, v), it.key);
+        continue;
+      }
+      const int u = tr[it.node].next[ord[it.node][it.i]];
+      if (it.i + 1 < deg[it.node])
+      {
+        const int s = tr[it.node].next[ord[it.node][it.i + 1]];
+        pq.push_back({best[s], it.node, it.i + 1}), push_heap(pq.begin(), pq.end());
+      }
+      expand(u);
+    }
+    return res;
+  }
+
+private:
+  void grow()
+  {
+    const size_t n = tr.size();
+    wt.resize(n, 0);
+    best.resize(n, 0);
+    ord.resize(n);
+    deg.resize(n, 0);
+    par.resize(n, -1);
+    pch.resize(n, 0);
+  }
+
+  // p の子列で文字 c を best 降順 (同点は文字順) の位置まで前へ詰める
+  void raise(int p, int c)
+  {
+    auto &o = ord[p];
+    int i = 0;
+    while (o[i] != c)
+      ++i;
+    const long long b = best[tr[p].next[c]];
+    for (; i > 0; --i)
+    {
+      const long long a = best[tr[p].next[o[i - 1]]];
+      if (a > b || (a == b && o[i - 1] < c))
+        break;
+      swap(o[i - 1], o[i]);
+    }
+  }
+
+  // 祖先 top から u までの辺の文字列
+  string suffix(int u, int top) const
+  {
+    string s;
+    for (; u != top; u = par[u])
+      s.push_back(char('a' + pch[u]));
+    reverse(s.begin(), s.end());
+    return s;
+  }
+};
+
+/*--------------------- benchmark / demo ---------------------*/
+// 重みが Zipf 風の 10^6 語で、短い接頭辞の上位 10 件を
+//   (a) top_k
+//   (b) Cursor で部分木を全部読んで partial_sort
+// で求めて比較する。
+#ifndef AUTOCOMPLETE_NO_DEMO
+int main(int argc, char **argv)
+{
+  ios::sync_with_stdio(false);
+  cin.tie(nullptr);
+
+  AutocompleteTrie demo;
+  for (auto [w, f] : vector<pair<string, int>>{{"apple", 5}, {"app", 9}, {"apply", 2}, {"apt", 7}, {"banana", 3}})
+    demo.insert(w, f);
+  for (auto &[w, f] : demo.top_k("ap", 3))
+    cout << w << ":" << f << " "; // app:9 apt:7 apple:5
+  cout << "\n";
+
+  const int N = argc >= 2 ? atoi(argv[1]) : 1000000, Q = 2000, K = 10;
+  mt19937 rng(1);
+  const string freq = "eeeeeeettttaaaaoooiiinnnssshhrrdllcumwfgypbvkjxqz";
+  AutocompleteTrie ac;
+  vector<string> words(N);
+  for (int i = 0; i < N; ++i)
+  {
+    words[i].resize(3 + rng() % 12);
+    for (auto &c : words[i])
+      c = freq[rng() % freq.size()];
+    ac.insert(words[i], 1 + 1000000 / (1 + rng() % N)); // Zipf 風
+  }
+  vector<string> qs(Q);
+  for (auto &q : qs)
+    q = words[rng() % N].substr(0, 1 + rng() % 3);
+
+  using clk = chrono::steady_clock;
+  auto t0 = clk::now();
+  long long a = 0;
+  for (auto &q : qs)
+    for (auto &[w, f] : ac.top_k(q, K))
+      a += f;
+  auto t1 = clk::now();
+  long long b = 0, seen = 0;
+  Trie::Cursor it;
+  vector<long long> ws;
+  for (auto &q : qs)
+  {
+    ws.clear();
+    for (it.reset(ac, q); it.next();)
+      ws.push_back(ac.wt[it.node()]);
+    seen += ws.size();
+    const int m = min<int>(K, ws.size());
+    partial_sort(ws.begin(), ws.begin() + m, ws.end(), greater<>());
+    b += accumulate(ws.begin(), ws.begin() + m, 0LL);
+  }
+  auto t2 = clk::now();
+  auto us = [&](auto d)
+  { return chrono::duration<double, micro>(d).count() / Q; };
+  cout << "words=" << N << " nodes=" << ac.tr.size() << " avg matches/query=" << seen / Q << "\n"
+       << "top_k           " << us(t1 - t0) << " us/query\n"
+       << "scan + partial  " << us(t2 - t1) << " us/query  " << (a == b ? "same" : "MISMATCH") << '\n';
+}
+#endif
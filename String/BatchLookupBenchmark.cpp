@@ -0,0 +1,82 @@
+/************************************************************
+  まとめて照会 ベンチマーク
+  ----------------------------------------------------------
+  LLC に載らない大きさの Trie / SuffixArray で、1 件ずつの照会と
+  先読み付きのまとめて照会 (Trie::contains_batch / prefix_count_batch,
+  SuffixArray::lower_upper_batch) の時間を比べる。
+      g++ -O2 BatchLookupBenchmark.cpp && ./a.out [語数] [テキスト長]
+************************************************************/
+
+#include <bits/stdc++.h>
+#define TRIE_NO_DEMO
+#define SUFFIXARRAY_NO_DEMO
+#include "SuffixArray.cpp"
+#include "Trie.cpp"
+using namespace std;
+
+int main(int argc, char **argv)
+{
+  ios::sync_with_stdio(false);
+  cin.tie(nullptr);
+
+  const int N = argc >= 2 ? atoi(argv[1]) : 1000000, M = argc >= 3 ? atoi(argv[2]) : 4000000, Q = 1000000;
+  mt19937 rng(1);
+  using clk = chrono::steady_clock;
+  auto run = [&](const char *name, int q, auto fn)
+  {
+    auto t0 = clk::now();
+    long long chk = fn();
+    cout << name << " : " << chrono::duration<double, nano>(clk::now() - t0).count() / q << " ns/query  (chk=" << chk
+         << ")\n";
+  };
+
+  // 1. Trie (1 ノード 112 byte, 10^6 語で約 500 MB)
+  const string freq = "eeeeeeettttaaaaoooiiinnnssshhrrdllcumwfgypbvkjxqz";
+  vector<string> words(N), qs(Q);
+  for (auto &w : words)
+  {
+    w.resize(3 + rng() % 12);
+    for (auto &c : w)
+      c = freq[rng() % freq.size()];
+  }
+  for (auto &q : qs)
+    q = rng() % 2 ? words[rng() % N] : words[rng() % N].substr(0, 2 + rng() % 6);
+  Trie tr;
+  for (auto &w : words)
+    tr.insert(w);
+  cout << "Trie nodes=" << tr.tr.size() << " (" << tr.tr.size() * sizeof(Trie::Node) / 1048576 << " MiB)\n";
+  run("contains           ", Q, [&]
+      { long long c = 0; for (auto &q : qs) c += tr.contains(q); return c; });
+  run("contains_batch     ", Q, [&]
+      { auto r = tr.contains_batch(qs); return accumulate(r.begin(), r.end(), 0LL); });
+  run("prefix_count       ", Q, [&]
+      { long long c = 0; for (auto &q : qs) c += tr.prefix_count(q); return c; });
+  run("prefix_count_batch ", Q, [&]
+      { auto r = tr.prefix_count_batch(qs); return accumulate(r.begin(), r.end(), 0LL); });
+
+  // 2. SuffixArray (テキスト 1 byte + sa / rank / lcp 各 4 byte で 13 byte / 文字)
+  string T(M, 'a');
+  for (auto &c : T)
+    c = char('a' + rng() % 4);
+  SuffixArray sa(T);
+  const int QS = Q / 4;
+  vector<string> ps(QS);
+  for (auto &p : ps)
+    p = T.substr(rng() % (M - 32), 8 + rng() % 24);
+  cout << "SuffixArray |T|=" << M << " (" << (size_t)M * 13 / 1048576 << " MiB)\n";
+  run("lower_upper        ", QS, [&]
+      {
+        long long c = 0;
+        for (auto &p : ps)
+        {
+          auto [l, r] = sa.lower_upper(p);
+          c += r - l;
+        }
+        return c; });
+  run("lower_upper_batch  ", QS, [&]
+      {
+        long long c = 0;
+        for (auto [l, r] : sa.lower_upper_batch(ps))
+          c += r - l;
+        return c; });
+}
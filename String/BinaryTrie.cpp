@@ -0,0 +1,295 @@
+/************************************************************
+  Binary Trie  –  整数の多重集合を上位ビットから辿る 2 分木で管理
+  ----------------------------------------------------------
+  ◆ できること (B = ビット幅 32 / 64)                  | 時間計算量
+    - 挿入 / 削除 insert(x, k) / erase(x, k)             | O(B)
+    - 個数 count(x) / 全体 size()                        | O(B) / O(1)
+    - max_xor(q) = max(x ^ q) / min_xor(q) = min(x ^ q)  | O(B)
+    - count_less_xor(q, k) = #{x | (x ^ q) < k}          | O(B)
+    - kth(k, q) = (x ^ q) の小さい方から k 番目 (0-indexed) | O(B)
+    - ソート済み配列からの一括構築 build(sorted)          | O(ノード数)
+
+  ◆ 実装方針
+    * ノードは 2 本の子 nxt[2v], nxt[2v+1] と部分木の個数 cnt[v] を
+      それぞれフラットな配列で持つ (0 = 子無し、根 = 0 は子にならない)。
+    * erase で個数 0 になったノードは残したまま (cnt == 0 を「無い」と扱う)。
+      同じ値を再挿入すればそのまま再利用される。
+    * build は直前の値との共通上位ビットから下だけノードを作り、
+      ノードが行きがけ順に並ぶことを使って個数を逆順 1 パスで集計する。
+    * count_less(x) は count_less_xor(0, x)、k 番目に小さい値は kth(k)。
+
+  ◆ 典型用法
+      BinaryTrie<32> bt;                     // uint32_t の多重集合
+      bt.insert(5); bt.insert(9);
+      auto best = bt.max_xor(q);             // 空でないこと
+      int less = bt.count_less_xor(q, k);    // x ^ q < k を満たす個数
+      auto med = bt.kth(bt.size() / 2);
+      BinaryTrie<64> big; big.build(sorted_u64);
+************************************************************/
+
+#pragma once
+#include <bits/stdc++.h>
+using namespace std;
+
+template <int BITS = 32>
+struct BinaryTrie
+{
+  static_assert(BITS >= 1 && BITS <= 64);
+  using U = conditional_t<(BITS <= 32), uint32_t, uint64_t>;
+
+  vector<uint32_t> nxt; // nxt[2v + b] : ビット b の子
+  vector<int> cnt;      // 部分木の要素数
+
+  BinaryTrie() { clear(); }
+
+  void clear()
+  {
+    nxt.assign(2, 0);
+    cnt.assign(1, 0);
+  }
+
+  int size() const { return cnt[0]; }
+  bool empty() const { return cnt[0] == 0; }
+
+  void insert(U x, int k = 1)
+  {
+    uint32_t v = 0;
+    cnt[0] += k;
+    for (int i = BITS - 1; i >= 0; --i)
+    {
+      const int b = x >> i & 1;
+      if (!nxt[2 * v + b])
+      {
+        nxt[2 * v + b] = (uint32_t)cnt.size();
+        cnt.push_back(0);
+        nxt.push_back(0), nxt.push_back(0);
+      }
+      v = nxt[2 * v + b];
+      cnt[v] += k;
+    }
+  }
+
+  // x が k 個未満なら何もせず false
+  bool erase(U x, int k = 1)
+  {
+    if (count(x) < k)
+      return false;
+    uint32_t v = 0;
+    cnt[0] -= k;
+    for (int i = BITS - 1; i >= 0; --i)
+    {
+      v = nxt[2 * v + (x >> i & 1)];
+      cnt[v] -= k;
+    }
+    return true;
+  }
+
+  int count(U x) const
+  {
+    uint32_t v = 0;
+    for (int i = BITS - 1; i >= 0; --i)
+      if (!(v = nxt[2 * v + (x >> i & 1)]))
+        return 0;
+    return cnt[v];
+  }
+
+  // max(x ^ q) (空でないこと)
+  U max_xor(U q) const { return min_xor(q ^ mask()) ^ mask(); }
+
+  // min(x ^ q) (空でないこと)
+  U min_xor(U q) const
+  {
+    assert(!empty());
+    uint32_t v = 0;
+    U r = 0;
+    for (int i = BITS - 1; i >= 0; --i)
+    {
+      const int b = q >> i & 1;
+      const uint32_t same = nxt[2 * v + b];
+      if (same && cnt[same])
+        v = same;
+      else
+      {
+        v = nxt[2 * v + (b ^ 1)];
+        r |= U(1) << i;
+      }
+    }
+    return r;
+  }
+
+  // #{x | (x ^ q) < k}
+  int count_less_xor(U q, U k) const
+  {
+    uint32_t v = 0;
+    int res = 0;
+    for (int i = BITS - 1; i >= 0; --i)
+    {
+      const int b = q >> i & 1;
+      if (k >> i & 1)
+      { // (x ^ q) のこのビットが 0 の側はすべて k 未満
+        if (uint32_t w = nxt[2 * v + b])
+          res += cnt[w];
+        v = nxt[2 * v + (b ^ 1)];
+      }
+      else
+        v = nxt[2 * v + b];
+      if (!v)
+        break;
+    }
+    return res;
+  }
+
+  // (x ^ q) を昇順に並べた k 番目 (0-indexed, k < size())
+  U kth(int k, U q = 0) const
+  {
+    assert(0 <= k && k < size());
+    uint32_t v = 0;
+    U r = 0;
+    for (int i = BITS - 1; i >= 0; --i)
+    {
+      const int b = q >> i & 1;
+      const uint32_t lo = nxt[2 * v + b];
+      const int c = lo ? cnt[lo] : 0;
+      if (k < c)
+        v = lo;
+      else
+      {
+        k -= c;
+        v = nxt[2 * v + (b ^ 1)];
+        r |= U(1) << i;
+      }
+    }
+    return r;
+  }
+
+  // 昇順 (重複可) の列から作り直す
+  void build(const vector<U> &sorted)
+  {
+    clear();
+    const int n = (int)sorted.size();
+    if (n == 0)
+      return;
+    // ノード数 = 1 + Σ (直前の値と異なる下位部分の深さ)
+    size_t total = 1 + BITS;
+    for (int j = 1; j < n; ++j)
+    {
+      assert(sorted[j - 1] <= sorted[j]);
+      total += depth_diff(sorted[j - 1], sorted[j]);
+    }
+    nxt.assign(2 * total, 0);
+    cnt.assign(total, 0);
+
+    uint32_t path[BITS + 1] = {0}; // path[d] : 深さ d のノード
+    uint32_t next_id = 1;
+    for (int j = 0; j < n; ++j)
+    {
+      const U x = sorted[j];
+      const int d = j ? BITS - depth_diff(sorted[j - 1], x) : 0; // 共有する深さ
+      for (int t = d; t < BITS; ++t)
+      {
+        const uint32_t w = next_id++;
+        nxt[2 * path[t] + (x >> (BITS - 1 - t) & 1)] = w;
+        path[t + 1] = w;
+      }
+      ++cnt[path[BITS]];
+    }
+    // 行きがけ順なので子は親より後ろ → 逆順に足し上げる
+    for (int v = (int)total - 1; v >= 0; --v)
+      for (int b = 0; b < 2; ++b)
+        if (uint32_t w = nxt[2 * v + b])
+          cnt[v] += cnt[w];
+  }
+
+private:
+  static constexpr U mask() { return BITS == 64 ? ~U(0) : U((uint64_t(1) << BITS) - 1); }
+
+  // a と b で作り直す必要のある深さ (上位の共通ビットより下の段数)
+  static int depth_diff(U a, U b)
+  {
+    if (a == b)
+      return 0;
+    return 64 - __builtin_clzll((uint64_t)(a ^ b)); // 最上位の異なるビット位置 + 1
+  }
+};
+
+/*--------------------- benchmark / demo ---------------------*/
+// ソート済み配列 + 線形走査で答える従来方式と比較
+#ifndef BINARYTRIE_NO_DEMO
+int main(int argc, char **argv)
+{
+  ios::sync_with_stdio(false);
+  cin.tie(nullptr);
+
+  const int N = argc >= 2 ? atoi(argv[1]) : 200000, Q = 2000;
+  mt19937 rng(1);
+  using clk = chrono::steady_clock;
+  auto us = [](auto d, int k)
+  { return chrono::duration<double, micro>(d).count() / k; };
+
+  // 1. 動的な多重集合 : 挿入 / 削除の合間に各種クエリ
+  BinaryTrie<32> bt;
+  vector<uint32_t> sorted;
+  vector<uint32_t> ops(N);
+  for (auto &x : ops)
+    x = rng() % (1u << 20);
+  auto t0 = clk::now();
+  long long a = 0;
+  for (int i = 0; i < N; ++i)
+  {
+    bt.insert(ops[i]);
+    if (i % 3 == 2)
+      bt.erase(ops[i / 2]);
+    if (i % (N / Q) == 0)
+    {
+      const uint32_t q = ops[i] * 7;
+      a += bt.max_xor(q) + bt.min_xor(q) + bt.count_less_xor(q, 1u << 19) + bt.kth(bt.size() / 2);
+    }
+  }
+  auto t1 = clk::now();
+  long long b = 0;
+  for (int i = 0; i < N; ++i)
+  {
+    sorted.insert(lower_bound(sorted.begin(), sorted.end(), ops[i]), ops[i]);
+    if (i % 3 == 2)
+      if (auto it = lower_bound(sorted.begin(), sorted.end(), ops[i / 2]); it != sorted.end() && *it == ops[i / 2])
+        sorted.erase(it);
+    if (i % (N / Q) == 0)
+    {
+      const uint32_t q = ops[i] * 7;
+      uint32_t mx = 0, mn = UINT32_MAX;
+      int less = 0;
+      for (uint32_t x : sorted)
+      {
+        mx = max(mx, x ^ q), mn = min(mn, x ^ q);
+        less += (x ^ q) < (1u << 19);
+      }
+      b += (long long)mx + mn + less + sorted[sorted.size() / 2];
+    }
+  }
+  auto t2 = clk::now();
+  cout << "dynamic multiset  BinaryTrie " << us(t1 - t0, N) << " us/op  sorted vector + scan " << us(t2 - t1, N)
+       << " us/op  " << (a == b ? "same" : "MISMATCH") << '\n';
+
+  // 2. 一括構築 : 1 個ずつ insert と比較 (64 bit)
+  vector<uint64_t> big(10 * N);
+  for (auto &x : big)
+    x = (uint64_t)rng() << 32 | rng();
+  sort(big.begin(), big.end());
+  auto s0 = clk::now();
+  BinaryTrie<64> b1;
+  for (auto x : big)
+    b1.insert(x);
+  auto s1 = clk::now();
+  BinaryTrie<64> b2;
+  b2.build(big);
+  auto s2 = clk::now();
+  bool same = b1.size() == b2.size();
+  for (int k = 0; k < 1000 && same; ++k)
+  {
+    uint64_t q = (uint64_t)rng() << 32 | rng();
+    same = b1.max_xor(q) == b2.max_xor(q) && b1.kth(k) == b2.kth(k) && b1.count_less_xor(q, q >> 1) == b2.count_less_xor(q, q >> 1);
+  }
+  cout << "build " << big.size() << " x 64 bit  insert " << us(s1 - s0, 1) / 1000 << " ms  build "
+       << us(s2 - s1, 1) / 1000 << " ms  " << (same ? "same" : "MISMATCH") << '\n';
+}
+#endif
@@ -0,0 +1,198 @@
+/************************************************************
+  Dynamic Rolling Hash  –  1 文字書き換えに O(log N) で追従するハッシュ列
+  ----------------------------------------------------------
+  ◆ できること (N = 長さ)                    | 時間計算量
+    - 構築 build(s)                          | O(N)
+    - 1 要素書き換え set(i, x)               | O(log N)
+    - 区間ハッシュ get(l, r)  ※r exclusive   | O(log N)
+    - 反転区間ハッシュ get_rev(l, r)          | O(log N)
+    - 2 区間の一致判定 same(l1,r1,l2,r2)      | O(log N)
+    - 回文判定 is_pal(h, l, r)               | O(log N)
+
+  ◆ 実装方針
+    * RollingHash と同じ mod 2^61-1 / 同じ base / 同じ要素変換を使うので、
+      get(l, r) は同じ内容の RollingHash::get(l, r) と一致する
+      (静的なパターンの RollingHash と直接比較できる)。
+    * 順方向は code(s_i) * b^(N-1-i)、逆方向は code(s_i) * b^i を
+      それぞれ Fenwick 木に持ち、区間和に b^-(N-r) / b^-l を掛けて正規化。
+    * 長さは固定 (insert / erase は無し。長さが変わったら build し直す)。
+
+  ◆ 典型用法
+      DynamicRollingHash h(S);
+      h.set(i, 'x');                         // S[i] = 'x'
+      if (h.same(l1, r1, l2, r2)) ...        // 半開区間どうし
+      if (is_pal(h, l, r)) ...               // [l, r) が回文か
+************************************************************/
+
+#pragma once
+#include <bits/stdc++.h>
+#define ROLLINGHASH_NO_DEMO
+#include "RollingHash.cpp"
+using namespace std;
+
+struct DynamicRollingHash
+{
+  using ull = unsigned long long;
+  static constexpr ull MOD = RollingHash::MOD;
+
+  int n = 0;
+  vector<ull> fwd, rev;   // Fenwick 木 (1-indexed)
+  vector<ull> cur;        // 各位置の code
+  vector<ull> ipw;        // b^-k
+  shared_ptr<const vector<ull>> pow_table;
+  const ull *pw = nullptr;
+
+  DynamicRollingHash() = default;
+  template <class Seq>
+  explicit DynamicRollingHash(const Seq &s) { build(s); }
+
+  template <class Seq>
+  void build(const Seq &s)
+  {
+    n = (int)s.size();
+    pow_table = RollingHash::powers(n + 1);
+    pw = pow_table->data();
+    ipw.resize(n + 1);
+    ipw[0] = 1;
+    const ull ib = inverse(RollingHash::base());
+    for (int k = 0; k < n; ++k)
+      ipw[k + 1] = RollingHash::mul(ipw[k], ib);
+
+    cur.resize(n);
+    fwd.assign(n + 1, 0);
+    rev.assign(n + 1, 0);
+    for (int i = 0; i < n; ++i)
+    {
+      cur[i] = RollingHash::code(s[i]);
+      fwd[i + 1] = RollingHash::mul(cur[i], pw[n - 1 - i]);
+      rev[i + 1] = RollingHash::mul(cur[i], pw[i]);
+    }
+    for (int i = 1; i <= n; ++i) // O(N) で Fenwick 化
+      if (int j = i + (i & -i); j <= n)
+      {
+        fwd[j] = add(fwd[j], fwd[i]);
+        rev[j] = add(rev[j], rev[i]);
+      }
+  }
+
+  int size() const { return n; }
+
+  // s[i] = x
+  template <class T>
+  void set(int i, const T &x)
+  {
+    const ull c = RollingHash::code(x);
+    if (c == cur[i])
+      return;
+    const ull d = c + MOD - cur[i]; // 差分 (mod 前)
+    cur[i] = c;
+    const ull df = RollingHash::mul(d % MOD, pw[n - 1 - i]);
+    const ull dr = RollingHash::mul(d % MOD, pw[i]);
+    for (int k = i + 1; k <= n; k += k & -k)
+    {
+      fwd[k] = add(fwd[k], df);
+      rev[k] = add(rev[k], dr);
+    }
+  }
+
+  // 半開区間 [l,r) のハッシュ (RollingHash::get と同じ値)
+  ull get(int l, int r) const
+  {
+    return RollingHash::mul(sub(prefix(fwd, r), prefix(fwd, l)), ipw[n - r]);
+  }
+
+  // [l,r) を反転した列のハッシュ
+  ull get_rev(int l, int r) const
+  {
+    return RollingHash::mul(sub(prefix(rev, r), prefix(rev, l)), ipw[l]);
+  }
+
+  bool same(int l1, int r1, int l2, int r2) const
+  {
+    return (r1 - l1) == (r2 - l2) && get(l1, r1) == get(l2, r2);
+  }
+
+private:
+  static ull add(ull a, ull b)
+  {
+    a += b;
+    return a >= MOD ? a - MOD : a;
+  }
+  static ull sub(ull a, ull b) { return a >= b ? a - b : a + MOD - b; }
+
+  static ull inverse(ull a)
+  {
+    ull r = 1;
+    for (ull e = MOD - 2; e; e >>= 1, a = RollingHash::mul(a, a))
+      if (e & 1)
+        r = RollingHash::mul(r, a);
+    return r;
+  }
+
+  static ull prefix(const vector<ull> &bit, int r)
+  {
+    ull s = 0;
+    for (; r > 0; r &= r - 1)
+      s = add(s, bit[r]);
+    return s;
+  }
+};
+
+/// 区間 [l,r) が回文か判定 (DynamicRollingHash 版)
+bool is_pal(const DynamicRollingHash &h, int l, int r)
+{
+  return h.get(l, r) == h.get_rev(l, r);
+}
+
+/*--------------------- benchmark / demo ---------------------*/
+// 編集 1 回ごとに RollingHash を作り直す方式と比較 (N = 10^6)
+#ifndef DYNAMICROLLINGHASH_NO_DEMO
+int main()
+{
+  ios::sync_with_stdio(false);
+  cin.tie(nullptr);
+
+  const int N = 1000000, E = 200000, R = 200;
+  mt19937 rng(1);
+  string S(N, 'a');
+  for (auto &c : S)
+    c = char('a' + rng() % 2);
+
+  using clk = chrono::steady_clock;
+  auto t0 = clk::now();
+  DynamicRollingHash h(S);
+  long long yes = 0;
+  for (int e = 0; e < E; ++e)
+  {
+    int i = rng() % N, len = rng() % 64 + 1, l = rng() % (N - len), m = rng() % (N - len);
+    S[i] = char('a' + rng() % 2);
+    h.set(i, S[i]);
+    yes += h.same(l, l + len, m, m + len) + is_pal(h, l, l + len);
+  }
+  auto t1 = clk::now();
+  string W = S; // 作り直し側は別の写しを編集する (h は S と同じ内容のまま)
+  for (int e = 0; e < R; ++e)
+  {
+    int i = rng() % N, len = rng() % 64 + 1, l = rng() % (N - len), m = rng() % (N - len);
+    W[i] = char('a' + rng() % 2);
+    RollingHash fw(W), rv(string(W.rbegin(), W.rend()));
+    yes += fw.same(l, l + len, m, m + len) + is_pal(fw, rv, l, l + len, N);
+  }
+  auto t2 = clk::now();
+  auto us = [](auto d, int k)
+  { return chrono::duration<double, micro>(d).count() / k; };
+  cout << "DynamicRollingHash  " << us(t1 - t0, E) << " us/edit\n"
+       << "rebuild RollingHash " << us(t2 - t1, R) << " us/edit\n"
+       << "(yes=" << yes << ")\n";
+
+  // 静的な RollingHash と同じ値になる
+  RollingHash st(S);
+  bool same = true;
+  for (int k = 0; k < 1000; ++k)
+  {
+    int l = rng() % N, r = l + rng() % (N - l + 1);
+    same &= st.get(l, r) == h.get(l, r);
+  }
+  cout << "same as RollingHash: " << boolalpha << same << '\n';
+}
+#endif
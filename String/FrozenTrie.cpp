@@ -0,0 +1,229 @@
+/************************************************************
+  Frozen Trie  –  構築済み Trie を読み取り専用のコンパクト配列に変換
+  ----------------------------------------------------------
+  ◆ できること (L = 文字列長, σ = 子の数 ≤ 26) | 時間計算量
+    - 変換 FrozenTrie(const Trie&)            | O(ノード数)
+    - 完全一致判定 contains(s)                | O(Lσ)  ※兄弟の Rec を連続走査
+    - 接頭辞出現回数 prefix_count(p)           | O(Lσ)
+    - 最短一意接頭辞 min_unique(s)             | O(Lσ)
+    - 辞書順列挙 enumerate()                  | O(∑|s|)  ※再帰なし
+    意味は Trie の同名関数と同じ (multiset の重複も保つ)
+
+  ◆ 実装方針 (LOUDS 風のレイアウト)
+    * 各ノードの子を連番の塊にして辞書順に並べ、塊は DFS 順に割り当てる。
+      Rec (8 byte) = {子の塊の先頭 26 bit | 終端フラグ | 子の数 5 bit,
+                      cnt 27 bit | 辺の文字 5 bit}。
+      子を探すと兄弟の Rec が 1 本のキャッシュラインに載り、次の段の
+      子の範囲もそのまま読める。一本道の語尾は連続した Rec になる。
+    * ノード数は 2^26 未満、語数は 2^27 未満。
+    * 1 ノードあたり Rec 8 + term 1 = 9 byte (Trie::Node は 112 byte)。
+      term が 255 以上のノードだけ term_big に逃がす。
+    * 'a'-'z' 以外の文字を問い合わせても範囲外アクセスしない (単に不一致)。
+
+  ◆ 典型用法
+      Trie tr;
+      for (auto &w : dict) tr.insert(w);
+      FrozenTrie ft(tr);                     // 以降 tr は捨ててよい
+      if (ft.contains("apple")) ...
+      int num = ft.prefix_count("app");
+************************************************************/
+
+#pragma once
+#include <bits/stdc++.h>
+#define TRIE_NO_DEMO
+#include "Trie.cpp"
+using namespace std;
+
+struct FrozenTrie
+{
+  struct Rec
+  {
+    uint32_t fd; // (子の塊の先頭 << 6) | (終端か << 5) | 子の数
+    uint32_t cl; // (この節点以下の文字列総数 << 5) | 入ってくる辺の文字 (0..25)
+  };
+  vector<Rec> rec;
+  vector<uint8_t> term; // 完全一致個数 (255 で飽和)
+  unordered_map<int, int> term_big;
+
+  FrozenTrie() = default;
+  explicit FrozenTrie(const Trie &t) { build(t); }
+
+  void build(const Trie &t)
+  {
+    const int n = (int)t.tr.size();
+    // cnt は 27 bit に詰める。Trie は根の cnt を数えないので語数は子の cnt の和 + 根の term
+    long long words = t.tr[0].term;
+    for (int c = 0; c < Trie::ALPHA; ++c)
+      if (t.tr[0].next[c] != -1)
+        words += t.tr[t.tr[0].next[c]].cnt;
+    assert(n < (1 << 26) && words < (1 << 27));
+    // 子の塊を DFS 順に割り当てる (一本道の語尾が連続した Rec に並ぶ)
+    vector<int> order(n), st = {0};
+    rec.assign(n, Rec{0, 0});
+    term.resize(n);
+    term_big.clear();
+    int next_id = 1;
+    while (!st.empty())
+    {
+      const int k = st.back();
+      st.pop_back();
+      const auto &nd = t.tr[order[k]];
+      const int first = next_id;
+      for (int c = 0; c < Trie::ALPHA; ++c)
+        if (nd.next[c] != -1)
+        {
+          rec[next_id].cl = c;
+          order[next_id++] = nd.next[c];
+        }
+      rec[k].fd = (uint32_t)first << 6 | (nd.term > 0) << 5 | (next_id - first);
+      rec[k].cl |= (uint32_t)nd.cnt << 5;
+      term[k] = (uint8_t)min(nd.term, 255);
+      if (nd.term >= 255)
+        term_big[k] = nd.term;
+      for (int u = next_id - 1; u >= first; --u)
+        st.push_back(u);
+    }
+  }
+
+  int size() const { return (int)term.size(); }
+
+  size_t memory_bytes() const
+  {
+    return rec.size() * sizeof(Rec) + term.size() + term_big.size() * 16;
+  }
+
+  int cnt(int v) const { return (int)(rec[v].cl >> 5); }
+
+  // v の子で文字 ch のもの (無ければ -1)
+  //   兄弟の Rec は連続しているので、1 段進むのに触るキャッシュラインはほぼ 1 本
+  int child(int v, char ch) const
+  {
+    const uint32_t c = (uint32_t)(ch - 'a');
+    if (c >= (uint32_t)Trie::ALPHA)
+      return -1;
+    const uint32_t u0 = rec[v].fd >> 6, e = u0 + (rec[v].fd & 31);
+    for (uint32_t u = u0; u < e; ++u)
+      if ((rec[u].cl & 31) == c)
+        return (int)u;
+    return -1;
+  }
+
+  int term_count(int v) const { return term[v] < 255 ? term[v] : term_big.find(v)->second; }
+
+  bool contains(const string &s) const
+  {
+    int v = walk(s);
+    return v != -1 && (rec[v].fd >> 5 & 1);
+  }
+
+  int prefix_count(const string &p) const
+  {
+    int v = walk(p);
+    return v == -1 ? 0 : cnt(v);
+  }
+
+  // 最短一意接頭辞を返す（語が一意でなければ ""）
+  string min_unique(const string &s) const
+  {
+    int v = 0;
+    for (int i = 0; i < (int)s.size(); ++i)
+    {
+      v = child(v, s[i]);
+      if (v == -1)
+        return ""; // 未登録
+      if (cnt(v) == term_count(v))
+        return s.substr(0, i + 1); // 以降はこの語のみ
+    }
+    return (term_count(v) == 1 ? s : "");
+  }
+
+  // 辞書順列挙 (明示スタック)
+  vector<string> enumerate() const
+  {
+    vector<string> out;
+    string cur;
+    vector<pair<int, int>> st = {{0, 0}}; // {ノード, 次に見る子の番号}
+    if (term[0])
+      out.push_back(cur);
+    while (!st.empty())
+    {
+      auto &[v, u] = st.back();
+      if (u == (int)(rec[v].fd & 31))
+      {
+        st.pop_back();
+        if (!cur.empty())
+          cur.pop_back();
+        continue;
+      }
+      int w = (int)(rec[v].fd >> 6) + u++;
+      cur.push_back(char('a' + (rec[w].cl & 31)));
+      if (term[w])
+        out.push_back(cur);
+      st.push_back({w, 0});
+    }
+    return out;
+  }
+
+private:
+  int walk(const string &s) const
+  {
+    int v = 0;
+    for (char ch : s)
+      if ((v = child(v, ch)) == -1)
+        return -1;
+    return v;
+  }
+};
+
+/*--------------------- benchmark / demo ---------------------*/
+// 英単語風のランダム辞書で Trie と FrozenTrie のメモリ・照会速度を比較
+#ifndef FROZENTRIE_NO_DEMO
+int main(int argc, char **argv)
+{
+  ios::sync_with_stdio(false);
+  cin.tie(nullptr);
+
+  const int N = argc >= 2 ? atoi(argv[1]) : 1000000;
+  mt19937 rng(1);
+  // 頻度に偏りのある文字で長さ 3..14 の語を作る
+  const string freq = "eeeeeeettttaaaaoooiiinnnssshhrrdllcumwfgypbvkjxqz";
+  vector<string> words(N), queries(N);
+  for (auto &w : words)
+  {
+    w.resize(3 + rng() % 12);
+    for (auto &c : w)
+      c = freq[rng() % freq.size()];
+  }
+  for (int i = 0; i < N; ++i)
+    queries[i] = rng() % 2 ? words[rng() % N] : words[rng() % N].substr(0, 2 + rng() % 4);
+
+  Trie tr;
+  for (auto &w : words)
+    tr.insert(w);
+  using clk = chrono::steady_clock;
+  auto t0 = clk::now();
+  FrozenTrie ft(tr);
+  auto t1 = clk::now();
+
+  auto bench = [&](const char *name, const auto &t, size_t bytes)
+  {
+    auto s0 = clk::now();
+    long long a = 0;
+    for (auto &q : queries)
+      a += t.contains(q);
+    auto s1 = clk::now();
+    for (auto &q : queries)
+      a += t.prefix_count(q);
+    auto s2 = clk::now();
+    auto ns = [&](auto d)
+    { return chrono::duration<double, nano>(d).count() / N; };
+    cout << name << " " << bytes / 1048576.0 << " MiB  contains " << ns(s1 - s0) << " ns  prefix_count "
+         << ns(s2 - s1) << " ns  (sum=" << a << ")\n";
+  };
+  cout << "words=" << N << " nodes=" << tr.tr.size() << " freeze "
+       << chrono::duration<double, milli>(t1 - t0).count() << " ms\n";
+  bench("Trie      ", tr, tr.tr.size() * sizeof(Trie::Node));
+  bench("FrozenTrie", ft, ft.memory_bytes());
+  cout << "same enumerate: " << boolalpha << (tr.enumerate() == ft.enumerate()) << '\n';
+}
+#endif
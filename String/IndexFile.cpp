@@ -0,0 +1,454 @@
+/************************************************************
+  Index File  –  Trie / SuffixArray を保存し、mmap してそのまま照会する
+  ----------------------------------------------------------
+  ◆ できること
+    - 保存 save_index(path, trie) / save_index(path, sa)      | O(サイズ)
+    - 読み込み TrieView::open / SuffixArrayView::open         | O(1)  ※verify 時 O(サイズ)
+    - ビューの照会 (元の構造体と同じ名前・同じ結果)
+        TrieView        : contains / prefix_count / min_unique / Cursor
+        SuffixArrayView : lower_upper (_batch) / sa / rank / lcp / text
+
+  ◆ ファイル形式 (version 1)
+      [IndexHeader 256 byte][節 0][節 1]...   各節の先頭は 64 byte 境界
+        Trie        : 節 0 = Trie::tr (Node の配列をそのまま)
+        SuffixArray : 節 0 = テキスト, 1 = sa, 2 = rank, 3 = lcp
+    * 互換性チェック : magic, version, 種類, バイト順, 要素サイズ (sizeof(Node) など)。
+      ずれていれば open は false を返し、error に理由を入れる。
+    * 節の長さの整合 (Trie はノード数 >= 1、SA は テキスト長 n に対し
+      sa / rank が n 個・lcp が n-1 個) は O(1) なので常に検査する。
+      TrieView の子番号は辿るときにノード数未満かを見る (範囲外は子無し)。
+      SuffixArrayView の検索も sa の値が n 以上なら空の接尾辞として扱う
+      (壊れたファイルの結果は不定だが、テキストの外は読まない)。
+      rank / lcp をそのまま添字に使うなら verify = true で開くこと。
+    * 節ごとに 64 bit チェックサム。open(path, true) で全節を検査する
+      (全ページを読むので、起動を最短にしたいときは false)。
+    * 保存は path.tmp に書いて fsync → rename → ディレクトリを fsync。
+      途中でプロセスが落ちても電源が落ちても、path は古い索引か
+      新しい索引のどちらか丸ごとになる。
+    * 読み込みはコピーせず、mmap したページを直接指す (MappedFile を使用)。
+      ページは最初に触れたときに読まれるので、起動は照会数に比例するだけ。
+    * 書き出した処理系と同じバイト順・同じ int 幅でしか読めない
+      (可搬な変換はしない。不一致は互換性チェックで弾く)。
+
+  ◆ 典型用法
+      save_index("words.idx", trie);             // 一度だけ
+      TrieView tv;
+      if (!tv.open("words.idx")) cerr << tv.error;
+      tv.contains("apple"); tv.prefix_count("app");
+
+      save_index("text.idx", SuffixArray(S));
+      SuffixArrayView sv;
+      sv.open("text.idx", false);                // 検査なしで即座に
+      auto [l, r] = sv.lower_upper(P);
+************************************************************/
+
+#pragma once
+#include <bits/stdc++.h>
+#define TRIE_NO_DEMO
+#define SUFFIXARRAY_NO_DEMO
+#include "MappedFile.cpp"
+#include "SuffixArray.cpp"
+#include "Trie.cpp"
+using namespace std;
+
+struct IndexHeader
+{
+  static constexpr char MAGIC[8] = {'S', 'T', 'R', 'I', 'D', 'X', '\r', '\n'};
+  static constexpr uint32_t VERSION = 1, ENDIAN = 0x01020304;
+  static constexpr int MAX_SEC = 8, ALIGN = 64;
+  enum Kind : uint32_t
+  {
+    TRIE = 1,
+    SUFFIX_ARRAY = 2
+  };
+  struct Section
+  {
+    uint64_t off, len, hash; // byte 単位
+  };
+
+  char magic[8];
+  uint32_t version, kind, endian, elem; // elem : 主要な要素のサイズ
+  uint32_t nsec, reserved[3];
+  Section sec[MAX_SEC];
+  char pad[256 - 40 - MAX_SEC * sizeof(Section)];
+
+  static constexpr uint64_t rot(uint64_t x, int r) { return x << r | x >> (64 - r); }
+
+  // 64 bit チェックサム (8 byte ずつ 4 本並行に混ぜる)
+  static uint64_t checksum(const char *p, size_t n)
+  {
+    constexpr uint64_t P1 = 0x9E3779B185EBCA87ull, P2 = 0xC2B2AE3D27D4EB4Full;
+    uint64_t h[4] = {P1, P2, ~P1, ~P2};
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32)
+      for (int k = 0; k < 4; ++k)
+      {
+        uint64_t x;
+        memcpy(&x, p + i + 8 * k, 8);
+        h[k] = rot(h[k] + x * P2, 31) * P1;
+      }
+    uint64_t r = n * P1;
+    for (int k = 0; k < 4; ++k)
+      r = rot(r ^ h[k] * P2, 27) * P1 + P2;
+    for (; i < n; ++i)
+      r = rot(r ^ (unsigned char)p[i] * P1, 11) * P2;
+    return r ^ r >> 29;
+  }
+};
+static_assert(sizeof(IndexHeader) == 256);
+
+namespace index_file_impl
+{
+  // path (ファイルまたはディレクトリ) の内容をディスクまで書き出す
+  inline bool sync_path(const string &path)
+  {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+      return false;
+    bool ok = fsync(fd) == 0;
+    ::close(fd);
+    return ok;
+  }
+
+  // 節 (ポインタ, byte 数) の並びを path.tmp に書き出してから path へ rename する
+  inline bool write(const string &path, uint32_t kind, uint32_t elem, const vector<pair<const char *, size_t>> &secs)
+  {
+    IndexHeader h{};
+    memcpy(h.magic, IndexHeader::MAGIC, 8);
+    h.version = IndexHeader::VERSION;
+    h.kind = kind;
+    h.endian = IndexHeader::ENDIAN;
+    h.elem = elem;
+    h.nsec = (uint32_t)secs.size();
+    uint64_t off = sizeof(IndexHeader);
+    for (size_t k = 0; k < secs.size(); ++k)
+    {
+      h.sec[k] = {off, secs[k].second, IndexHeader::checksum(secs[k].first, secs[k].second)};
+      off = (off + secs[k].second + IndexHeader::ALIGN - 1) / IndexHeader::ALIGN * IndexHeader::ALIGN;
+    }
+    const string tmp = path + ".tmp";
+    {
+      ofstream out(tmp, ios::binary | ios::trunc);
+      out.write((const char *)&h, sizeof h);
+      static const char zero[IndexHeader::ALIGN] = {};
+      for (size_t k = 0; k < secs.size(); ++k)
+      {
+        out.write(secs[k].first, secs[k].second);
+        const uint64_t end = h.sec[k].off + h.sec[k].len;
+        out.write(zero, (IndexHeader::ALIGN - end % IndexHeader::ALIGN) % IndexHeader::ALIGN);
+      }
+      out.close();
+      if (!out || !sync_path(tmp))
+        return remove(tmp.c_str()), false;
+    }
+    if (rename(tmp.c_str(), path.c_str()) != 0)
+      return remove(tmp.c_str()), false;
+    const size_t slash = path.find_last_of('/');
+    return sync_path(slash == string::npos ? "." : slash == 0 ? "/" : path.substr(0, slash)); // rename を確定
+  }
+
+  // ヘッダを検査して節の先頭ポインタを返す (失敗なら error を設定して空)
+  //   チェックサムは verify のときだけ、それ以外 (O(1)) は常に検査する
+  inline vector<const char *> check(const MappedFile &f, uint32_t kind, uint32_t elem, uint32_t nsec, bool verify,
+                                    const char *&error)
+  {
+    if (f.size < sizeof(IndexHeader))
+      return error = "too small or unreadable", vector<const char *>{};
+    IndexHeader h;
+    memcpy(&h, f.data, sizeof h);
+    if (memcmp(h.magic, IndexHeader::MAGIC, 8) != 0)
+      return error = "not an index file", vector<const char *>{};
+    if (h.endian != IndexHeader::ENDIAN)
+      return error = "byte order mismatch", vector<const char *>{};
+    if (h.version != IndexHeader::VERSION)
+      return error = "unsupported version", vector<const char *>{};
+    if (h.kind != kind || h.nsec != nsec)
+      return error = "wrong index kind", vector<const char *>{};
+    if (h.elem != elem)
+      return error = "element layout mismatch", vector<const char *>{};
+    vector<const char *> p(nsec);
+    for (uint32_t k = 0; k < nsec; ++k)
+    {
+      const auto &s = h.sec[k];
+      if (s.off % IndexHeader::ALIGN || s.off > f.size || s.len > f.size - s.off)
+        return error = "truncated", vector<const char *>{};
+      p[k] = f.data + s.off;
+      if (verify && IndexHeader::checksum(p[k], s.len) != s.hash)
+        return error = "checksum mismatch", vector<const char *>{};
+    }
+    error = nullptr;
+    return p;
+  }
+
+  inline uint64_t sec_len(const MappedFile &f, int k)
+  {
+    return ((const IndexHeader *)f.data)->sec[k].len;
+  }
+} // namespace index_file_impl
+
+inline bool save_index(const string &path, const Trie &t)
+{
+  return index_file_impl::write(path, IndexHeader::TRIE, sizeof(Trie::Node),
+                                {{(const char *)t.tr.data(), t.tr.size() * sizeof(Trie::Node)}});
+}
+
+inline bool save_index(const string &path, const SuffixArray &sa)
+{
+  auto bytes = [](const vector<int> &v)
+  { return pair<const char *, size_t>((const char *)v.data(), v.size() * sizeof(int)); };
+  return index_file_impl::write(path, IndexHeader::SUFFIX_ARRAY, sizeof(int),
+                                {{sa.text().data(), sa.text().size()}, bytes(sa.sa), bytes(sa.rank), bytes(sa.lcp)});
+}
+
+/*------------------------------------------------------------
+  TrieView : mmap した Trie の読み取り専用ビュー
+------------------------------------------------------------*/
+struct TrieView
+{
+  static constexpr int ALPHA = Trie::ALPHA;
+  MappedFile file;
+  const Trie::Node *tr = nullptr;
+  int n = 0;
+  const char *error = nullptr;
+
+  bool open(const string &path, bool verify = true)
+  {
+    tr = nullptr, n = 0;
+    if (!file.open(path))
+      return error = "cannot open", false;
+    auto p = index_file_impl::check(file, IndexHeader::TRIE, sizeof(Trie::Node), 1, verify, error);
+    if (p.empty())
+      return false;
+    const uint64_t len = index_file_impl::sec_len(file, 0);
+    if (len == 0 || len % sizeof(Trie::Node) || len / sizeof(Trie::Node) > (uint64_t)INT_MAX)
+      return error = "bad node count", false;
+    madvise((void *)file.data, file.size, MADV_RANDOM); // 照会は飛び飛びに読む
+    tr = (const Trie::Node *)p[0];
+    n = (int)(len / sizeof(Trie::Node));
+    return true;
+  }
+
+  int size() const { return n; }
+
+  // 子番号がノード数以上 (壊れたファイル) なら子無しとして扱う
+  int child(int v, char ch) const
+  {
+    const unsigned c = (unsigned)(ch - 'a');
+    if (c >= (unsigned)ALPHA)
+      return -1;
+    const int w = tr[v].next[c];
+    return (unsigned)w < (unsigned)n ? w : -1;
+  }
+
+  bool contains(const string &s) const
+  {
+    int v = walk(s);
+    return v != -1 && tr[v].term > 0;
+  }
+
+  int prefix_count(const string &p) const
+  {
+    int v = walk(p);
+    return v == -1 ? 0 : tr[v].cnt;
+  }
+
+  string min_unique(const string &s) const
+  {
+    int v = 0;
+    string res;
+    for (char ch : s)
+    {
+      if ((v = child(v, ch)) == -1)
+        return "";
+      res += ch;
+      if (tr[v].cnt == tr[v].term)
+        return res;
+    }
+    return (tr[v].term == 1 ? res : "");
+  }
+
+  Trie::Cursor with_prefix(const string &p) const { return Trie::Cursor(tr, p, n); }
+
+private:
+  int walk(const string &s) const
+  {
+    int v = 0;
+    for (char ch : s)
+      if ((v = child(v, ch)) == -1)
+        return -1;
+    return v;
+  }
+};
+
+/*------------------------------------------------------------
+  SuffixArrayView : mmap した SuffixArray の読み取り専用ビュー
+------------------------------------------------------------*/
+struct SuffixArrayView
+{
+  MappedFile file;
+  string_view S;
+  const int *sa = nullptr, *rank = nullptr, *lcp = nullptr; // 長さ n, n, n-1
+  int n = 0;
+  const char *error = nullptr;
+
+  bool open(const string &path, bool verify = true)
+  {
+    sa = rank = lcp = nullptr, n = 0;
+    if (!file.open(path))
+      return error = "cannot open", false;
+    auto p = index_file_impl::check(file, IndexHeader::SUFFIX_ARRAY, sizeof(int), 4, verify, error);
+    if (p.empty())
+      return false;
+    auto len = [&](int k)
+    { return index_file_impl::sec_len(file, k); };
+    const uint64_t m = len(0);
+    if (m == 0 || m > (uint64_t)INT_MAX || len(1) != m * sizeof(int) || len(2) != m * sizeof(int) ||
+        len(3) != (m - 1) * sizeof(int))
+      return error = "section length mismatch", false;
+    madvise((void *)file.data, file.size, MADV_RANDOM);
+    S = string_view(p[0], m);
+    sa = (const int *)p[1], rank = (const int *)p[2], lcp = (const int *)p[3];
+    n = (int)m;
+    return true;
+  }
+
+  int size() const { return n; }
+  const string_view &text() const { return S; }
+
+  // パターン P が現れる SA 区間 [l, r)
+  template <class Seq>
+  pair<int, int> lower_upper(const Seq &pat) const
+  {
+    return SuffixArray::lower_upper(sa, n, S, pat);
+  }
+
+  template <class Seq>
+  vector<pair<int, int>> lower_upper_batch(const vector<Seq> &pats) const
+  {
+    return SuffixArray::lower_upper_batch(sa, n, S, pats);
+  }
+};
+
+/*--------------------- benchmark / demo ---------------------*/
+// 起動時間 : 入力から作り直す / 索引ファイルを mmap (検査あり・なし)
+//   ページキャッシュから追い出してから測る (posix_fadvise DONTNEED)
+#ifndef INDEXFILE_NO_DEMO
+static void drop_cache(const string &path)
+{
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    return;
+  fdatasync(fd);
+  posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+  ::close(fd);
+}
+
+int main(int argc, char **argv)
+{
+  ios::sync_with_stdio(false);
+  cin.tie(nullptr);
+
+  const int N = argc >= 2 ? atoi(argv[1]) : 1000000, Q = 1000;
+  const string dir = argc >= 3 ? argv[2] : "/tmp";
+  mt19937 rng(1);
+  using clk = chrono::steady_clock;
+  auto ms = [](auto d)
+  { return chrono::duration<double, milli>(d).count(); };
+
+  // 1. Trie : 単語リストから作る vs 索引を開いて Q 件照会
+  const string freq = "eeeeeeettttaaaaoooiiinnnssshhrrdllcumwfgypbvkjxqz";
+  vector<string> words(N), qs(Q);
+  for (auto &w : words)
+  {
+    w.resize(3 + rng() % 12);
+    for (auto &c : w)
+      c = freq[rng() % freq.size()];
+  }
+  for (auto &q : qs)
+    q = words[rng() % N].substr(0, 2 + rng() % 6);
+  const string tpath = dir + "/words.idx", spath = dir + "/text.idx";
+  long long a = 0, b = 0, c = 0;
+  auto t0 = clk::now();
+  {
+    Trie tr;
+    for (auto &w : words)
+      tr.insert(w);
+    for (auto &q : qs)
+      a += tr.prefix_count(q);
+    auto t1 = clk::now();
+    save_index(tpath, tr);
+    cout << "Trie  nodes=" << tr.tr.size() << "  rebuild+query " << ms(t1 - t0) << " ms\n";
+  }
+  for (bool verify : {true, false})
+  {
+    drop_cache(tpath);
+    auto s0 = clk::now();
+    TrieView tv;
+    if (!tv.open(tpath, verify))
+    {
+      cout << "open failed: " << tv.error << '\n';
+      return 1;
+    }
+    long long &x = verify ? b : c;
+    for (auto &q : qs)
+      x += tv.prefix_count(q);
+    auto s1 = clk::now();
+    cout << "      mmap" << (verify ? " + verify" : "         ") << " + query " << ms(s1 - s0) << " ms  "
+         << (x == a ? "same" : "MISMATCH") << '\n';
+  }
+
+  // 2. SuffixArray : テキストから作る vs 索引を開いて Q 件検索
+  string T(N * 4, 'a');
+  for (auto &ch : T)
+    ch = char('a' + rng() % 4);
+  vector<string> ps(Q);
+  for (auto &p : ps)
+    p = T.substr(rng() % (T.size() - 16), 8 + rng() % 8);
+  a = b = c = 0;
+  auto u0 = clk::now();
+  {
+    SuffixArray sa(T);
+    for (auto &p : ps)
+    {
+      auto [l, r] = sa.lower_upper(p);
+      a += r - l;
+    }
+    auto u1 = clk::now();
+    save_index(spath, sa);
+    cout << "SA    |T|=" << T.size() << "  rebuild+query " << ms(u1 - u0) << " ms\n";
+  }
+  for (bool verify : {true, false})
+  {
+    drop_cache(spath);
+    auto s0 = clk::now();
+    SuffixArrayView sv;
+    if (!sv.open(spath, verify))
+    {
+      cout << "open failed: " << sv.error << '\n';
+      return 1;
+    }
+    long long &x = verify ? b : c;
+    for (auto &p : ps)
+    {
+      auto [l, r] = sv.lower_upper(p);
+      x += r - l;
+    }
+    auto s1 = clk::now();
+    cout << "      mmap" << (verify ? " + verify" : "         ") << " + query " << ms(s1 - s0) << " ms  "
+         << (x == a ? "same" : "MISMATCH") << '\n';
+  }
+
+  // 3. 互換性チェック : 壊れたファイルは開かない
+  {
+    fstream f(spath, ios::in | ios::out | ios::binary);
+    f.seekp(sizeof(IndexHeader) + 100);
+    f.put('#');
+  }
+  SuffixArrayView bad;
+  TrieView wrong;
+  cout << "corrupted: " << (bad.open(spath) ? "opened?!" : bad.error)
+       << "  wrong kind: " << (wrong.open(spath) ? "opened?!" : wrong.error) << '\n';
+  remove(tpath.c_str());
+  remove(spath.c_str());
+}
+#endif
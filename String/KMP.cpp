@@ -7,15 +7,24 @@
     - 出現回数カウント (count)      | O(N + M)
     - 最長 border 長 (lps.back())   | O(M)
     - 文字列の最小周期判定          | O(M)
+    - チャンク分割ストリーム検索    | O(Σ|chunk|)  ※KmpStream
+    - DFA 化した検索 (1 byte 1 参照) | O(N + Mσ)    ※KmpDfa
 
   ◆ 主要関数
       build_lps(pat) -> vector<int>
       kmp_search(text, pat) -> vector<int>
+      KmpPattern(pat)                     // lps 付きコンパイル済みパターン (pat は非空)
+      KmpStream(kp).feed(chunk, f)        // f(uint64_t 開始オフセット)
+      KmpDfa(pat).search(text) -> vector<int>
 
   ◆ 典型用法
       auto hit = kmp_search(T, P);        // 全位置
       bool ok  = !hit.empty();            // 存在するか
       int per  = P.size() - build_lps(P).back();  // 最小周期
+
+      KmpPattern kp(P);                   // 何本のストリームでも共有可
+      KmpStream st(kp);
+      while (read(buf)) st.feed(buf, [&](uint64_t pos){ ... });
 ************************************************************/
 
 #pragma once
@@ -68,13 +77,199 @@ vector<int> kmp_search(const string &text, const string &pat)
   return res;
 }
 
+/*------------------------------------------------------------
+  ストリーム版 KMP
+    - KmpPattern : pat と build_lps(pat) を保持 (不変なので共有可)
+    - KmpStream  : 照合状態 j と読了バイト数だけを持ち、
+                   feed(chunk, f) をチャンク境界を跨いで何度でも呼べる
+    * テキストはコピーせず、ヒットは全体先頭からの 64bit オフセットで f に渡す
+    * pat は非空であること
+------------------------------------------------------------*/
+struct KmpPattern
+{
+  string pat;
+  vector<int> lps;
+  explicit KmpPattern(string p) : pat(move(p)), lps(build_lps(pat))
+  {
+    assert(!pat.empty()); // feed は pat[0] を読む
+  }
+};
+
+struct KmpStream
+{
+  const KmpPattern *kp;
+  int j = 0;             // 現在一致している接頭辞長
+  uint64_t consumed = 0; // これまでに feed したバイト数
+
+  explicit KmpStream(const KmpPattern &p) : kp(&p) {}
+
+  void reset()
+  {
+    j = 0;
+    consumed = 0;
+  }
+
+  // f(pos) : pat が全体の [pos, pos+M) に現れた
+  template <class F>
+  void feed(string_view chunk, F f)
+  {
+    const string &pat = kp->pat;
+    const vector<int> &lps = kp->lps;
+    const int m = (int)pat.size();
+    const size_t n = chunk.size();
+    int jj = j;
+    for (size_t i = 0; i < n; ++i)
+    {
+      while (jj > 0 && chunk[i] != pat[jj])
+        jj = lps[jj - 1];
+      if (chunk[i] == pat[jj] && ++jj == m)
+      {
+        f(consumed + i + 1 - m);
+        jj = lps[jj - 1];
+      }
+    }
+    j = jj;
+    consumed += n;
+  }
+};
+
+/*------------------------------------------------------------
+  KmpDfa : lps を (M+1)×σ の完全遷移表に展開した KMP
+    * 失敗リンクの while ループが無く、テキスト 1 byte あたり表引き 1 回
+    * σ は pat に現れる byte 種類数 + 1 (それ以外の byte は 1 クラスに縮約)
+    * 表が max_cells を超える長いパターンは通常の lps 走査に自動で切替
+------------------------------------------------------------*/
+struct KmpDfa
+{
+  string pat;
+  vector<int> lps;
+  array<int, 256> cls{}; // byte → 文字クラス (0 = pat に現れない)
+  int sigma = 1;
+  vector<int> delta; // delta[j*sigma + c] : 状態 j (一致長) で c を読んだ後の状態 × sigma
+
+  explicit KmpDfa(string p, size_t max_cells = size_t(1) << 24)
+      : pat(move(p)), lps(build_lps(pat))
+  {
+    const int m = (int)pat.size();
+    for (unsigned char ch : pat)
+      if (!cls[ch])
+        cls[ch] = sigma++;
+    if (m == 0 || (size_t)(m + 1) * sigma > max_cells)
+      return; // dense 表を作らない (フォールバック)
+    delta.assign((size_t)(m + 1) * sigma, 0);
+    delta[cls[(unsigned char)pat[0]]] = sigma;
+    for (int j = 1; j <= m; ++j)
+    {
+      const int *from = &delta[(size_t)lps[j - 1] * sigma];
+      int *to = &delta[(size_t)j * sigma];
+      copy(from, from + sigma, to);
+      if (j < m)
+        to[cls[(unsigned char)pat[j]]] = (j + 1) * sigma;
+    }
+  }
+
+  bool dense() const { return !delta.empty(); }
+
+  // f(pos) : pat が text[pos, pos+M) に現れた
+  template <class F>
+  void search(string_view text, F f) const
+  {
+    const int m = (int)pat.size(), n = (int)text.size();
+    if (m == 0)
+    {
+      f(0); // kmp_search と同じく空パターンは 0 でヒット
+      return;
+    }
+    if (!dense())
+    {
+      for (int i = 0, j = 0; i < n; ++i)
+      {
+        while (j > 0 && text[i] != pat[j])
+          j = lps[j - 1];
+        if (text[i] == pat[j] && ++j == m)
+        {
+          f(i - m + 1);
+          j = lps[j - 1];
+        }
+      }
+      return;
+    }
+    // 状態は j*sigma で持ち、ループ内の乗算を省く
+    const int *d = delta.data(), acc = m * sigma;
+    for (int i = 0, js = 0; i < n; ++i)
+    {
+      js = d[js + cls[(unsigned char)text[i]]];
+      if (js == acc)
+        f(i - m + 1);
+    }
+  }
+
+  // kmp_search と同じ返り値
+  vector<int> search(const string &text) const
+  {
+    vector<int> res;
+    search(string_view(text), [&](int pos)
+           { res.push_back(pos); });
+    return res;
+  }
+};
+
+/*--------------------------- demo ---------------------------*/
+#ifndef KMP_NO_DEMO
+// kmp_search と KmpDfa の 1 byte あたりの所要時間 [ns/byte] を比較
+void bench_kmp_dfa()
+{
+  using clk = chrono::steady_clock;
+  const int N = 1 << 24;
+  mt19937 rng(1);
+
+  // 自然文風: 単語をランダムに並べたテキスト
+  const vector<string> words = {"error", "warning", "info", "request", "timeout", "user",
+                                "connection", "closed", "retry", "ok", "the", "at"};
+  string natural;
+  while ((int)natural.size() < N)
+    natural += words[rng() % words.size()] + ' ';
+  natural.resize(N);
+
+  auto run = [&](const string &name, const string &T, const string &P)
+  {
+    auto t0 = clk::now();
+    auto a = kmp_search(T, P);
+    auto t1 = clk::now();
+    KmpDfa dfa(P);
+    auto t2 = clk::now();
+    auto b = dfa.search(T);
+    auto t3 = clk::now();
+    auto ns = [&](auto d)
+    { return chrono::duration<double, nano>(d).count() / T.size(); };
+    cout << name << " hits=" << a.size() << (a == b ? "" : " (MISMATCH)")
+         << "  kmp " << ns(t1 - t0) << " ns/B,  dfa " << ns(t3 - t2)
+         << " ns/B (+build " << chrono::duration<double, milli>(t2 - t1).count() << " ms)\n";
+  };
+  // Fibonacci 語: border が深く入れ子になり失敗リンクを何段も辿る
+  string fa = "a", fb = "ab";
+  while ((int)fb.size() < N)
+    tie(fa, fb) = make_pair(fb, fb + fa);
+  fb.resize(N);
+  string rnd_ab(N, 'a');
+  for (auto &c : rnd_ab)
+    c = char('a' + rng() % 2);
+  run("fibonacci  ", fb, fa.substr(0, 4181));
+  run("random ab  ", rnd_ab, fa.substr(0, 21));
+  run("natural    ", natural, "connection closed");
+}
+
 int main()
 {
   ios::sync_with_stdio(false);
   cin.tie(nullptr);
 
   string T, P;
-  cin >> T >> P;
+  if (!(cin >> T >> P))
+  {
+    bench_kmp_dfa(); // 入力が無ければベンチマーク
+    return 0;
+  }
   auto pos = kmp_search(T, P);
 
   if (pos.empty())
@@ -91,3 +286,4 @@ int main()
     cout << '\n';
   }
 }
+#endif
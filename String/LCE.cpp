@@ -0,0 +1,151 @@
+/************************************************************
+  LCE (Longest Common Extension) カーネル  –  一致長を 8/32 byte 単位で伸ばす
+  ----------------------------------------------------------
+  ◆ できること (ℓ = 返す一致長)               | 時間計算量
+    - lce(a, i, b, j, lim)        a[i..] と b[j..] の一致長    | O(ℓ / w + 1)
+    - lce_mirror(a, l, r, lim)    a[l-k] == a[r+k] が続く長さ  | O(ℓ / w + 1)
+      (w = 32 byte (AVX2 でビルド時) / 8 byte)
+
+  ◆ 実装方針
+    * char 系の連続列 (string, string_view, vector<char> ...) なら
+      8 byte を XOR して ctz で最初の不一致 byte を求める。
+      -mavx2 等で __AVX2__ が定義されていれば 32 byte 比較も使う。
+    * それ以外の列 (vector<int> など) は 1 要素ずつ比較する。
+    * LCE_NAIVE を定義すると常に 1 要素ずつ比較 (LCEBenchmark.cpp の比較用)。
+
+  ◆ 利用箇所
+      z_algorithm / manacher / SuffixArray::build_lcp / SuffixArray::lower_upper
+
+  ◆ 典型用法
+      int k = lce(s, i, s, j, n - max(i, j));      // s[i..], s[j..] の LCP
+      int r = lce_mirror(s, c - 1, c, min(c, n - c)); // 偶数長回文の半径
+************************************************************/
+
+#pragma once
+#include <bits/stdc++.h>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+using namespace std;
+
+namespace lce_impl
+{
+  inline uint64_t load64(const char *p)
+  {
+    uint64_t x;
+    memcpy(&x, p, 8);
+    return x;
+  }
+
+  // a[k] == b[k] が続く長さ (k < lim)
+  inline size_t fwd(const char *a, const char *b, size_t lim)
+  {
+    size_t k = 0;
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    if (lim >= 8)
+    { // 短い一致で終わることが多いので最初の 8 byte は先に見る
+      uint64_t d = load64(a) ^ load64(b);
+      if (d)
+        return __builtin_ctzll(d) >> 3;
+      k = 8;
+    }
+#endif
+#ifdef __AVX2__
+    for (; k + 32 <= lim; k += 32)
+    {
+      __m256i x = _mm256_loadu_si256((const __m256i *)(a + k));
+      __m256i y = _mm256_loadu_si256((const __m256i *)(b + k));
+      unsigned ne = ~(unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y));
+      if (ne)
+        return k + __builtin_ctz(ne);
+    }
+#endif
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    for (; k + 8 <= lim; k += 8)
+    {
+      uint64_t d = load64(a + k) ^ load64(b + k);
+      if (d)
+        return k + (__builtin_ctzll(d) >> 3);
+    }
+#endif
+    while (k < lim && a[k] == b[k])
+      ++k;
+    return k;
+  }
+
+  // a[-k] == b[k] が続く長さ (k < lim)
+  inline size_t mirror(const char *a, const char *b, size_t lim)
+  {
+    if (a[0] != b[0])
+      return 0; // 回文の拡張は 1 文字目で止まることが最も多い
+    size_t k = 0;
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    for (; k + 8 <= lim; k += 8)
+    {
+      // a[-k-7 .. -k] を byte 反転すると先頭が a[-k] になる
+      uint64_t d = __builtin_bswap64(load64(a - k - 7)) ^ load64(b + k);
+      if (d)
+        return k + (__builtin_ctzll(d) >> 3);
+    }
+#endif
+    while (k < lim && a[-(ptrdiff_t)k] == b[k])
+      ++k;
+    return k;
+  }
+
+  // Seq が data() で 1 byte 整数の連続領域を返すか (C++17 の void_t で判定)
+  template <class Seq, class = void>
+  struct byte_data : false_type
+  {
+  };
+  template <class Seq>
+  struct byte_data<Seq, void_t<decltype(declval<const Seq &>().data())>>
+  {
+    using T = decay_t<decltype(*declval<const Seq &>().data())>;
+    static constexpr bool value = is_integral_v<T> && sizeof(T) == 1;
+  };
+
+  template <class Seq>
+  constexpr bool is_bytes()
+  {
+#ifdef LCE_NAIVE
+    return false;
+#else
+    return byte_data<Seq>::value;
+#endif
+  }
+} // namespace lce_impl
+
+// a[i+k] == b[j+k] が続く長さ (高々 lim)
+template <class A, class B>
+inline int lce(const A &a, int i, const B &b, int j, int lim)
+{
+  if (lim <= 0)
+    return 0;
+  if constexpr (lce_impl::is_bytes<A>() && lce_impl::is_bytes<B>())
+    return (int)lce_impl::fwd((const char *)a.data() + i, (const char *)b.data() + j, lim);
+  else
+  {
+    int k = 0;
+    while (k < lim && a[i + k] == b[j + k])
+      ++k;
+    return k;
+  }
+}
+
+// a[l-k] == a[r+k] が続く長さ (高々 lim)  ※回文の中心からの拡張用
+template <class A>
+inline int lce_mirror(const A &a, int l, int r, int lim)
+{
+  if (lim <= 0)
+    return 0;
+  if constexpr (lce_impl::is_bytes<A>())
+    return (int)lce_impl::mirror((const char *)a.data() + l, (const char *)a.data() + r, lim);
+  else
+  {
+    int k = 0;
+    while (k < lim && a[l - k] == a[r + k])
+      ++k;
+    return k;
+  }
+}
@@ -0,0 +1,76 @@
+/************************************************************
+  LCE カーネル ベンチマーク
+  ----------------------------------------------------------
+  長い繰り返しを含むテキストで、LCE.cpp を使う各アルゴリズム
+  (z_algorithm / manacher / SuffixArray 構築 (Kasai) / lower_upper)
+  の時間を表示する。同じファイルを 2 通りにビルドして比較する。
+      g++ -O2 -mavx2 LCEBenchmark.cpp               → カーネル使用 (after)
+      g++ -O2 -mavx2 -DLCE_NAIVE LCEBenchmark.cpp   → 1 文字ずつ (before)
+************************************************************/
+
+#include <bits/stdc++.h>
+#define MANACHER_NO_DEMO
+#define SUFFIXARRAY_NO_DEMO
+#include "Manacher.cpp"
+#include "SuffixArray.cpp"
+#include "ZAlgorithm.cpp"
+using namespace std;
+
+int main()
+{
+  ios::sync_with_stdio(false);
+  cin.tie(nullptr);
+
+  // 長い周期ブロック + ときどき変異 → 一致が数千 byte 続く
+  const int N = 1 << 20;
+  mt19937 rng(1);
+  string block(4096, 'a');
+  for (auto &c : block)
+    c = char('a' + rng() % 2);
+  string S;
+  while ((int)S.size() < N)
+  {
+    S += block;
+    S[rng() % S.size()] ^= 1;
+  }
+  S.resize(N);
+  string P = S.substr(N / 2, 20000);
+  string Q; // 短周期の回文 "abba" の繰り返し + 変異 → 長い回文だらけ (manacher 用)
+  while ((int)Q.size() < N)
+  {
+    Q += "abba";
+    if (rng() % 1024 == 0)
+      Q.back() ^= 1;
+  }
+  Q.resize(N);
+
+  using clk = chrono::steady_clock;
+  auto run = [&](const char *name, auto fn)
+  {
+    auto t0 = clk::now();
+    long long chk = fn();
+    cout << name << " : " << chrono::duration<double, milli>(clk::now() - t0).count()
+         << " ms  (chk=" << chk << ")\n";
+  };
+#ifdef LCE_NAIVE
+  cout << "[naive]\n";
+#else
+  cout << "[lce kernel]\n";
+#endif
+  run("z_algorithm      ", [&]
+      { auto z = z_algorithm(S); return accumulate(z.begin(), z.end(), 0LL); });
+  run("manacher         ", [&]
+      { auto [d1, d2] = manacher(Q); return accumulate(d1.begin(), d1.end(), 0LL) + accumulate(d2.begin(), d2.end(), 0LL); });
+  SuffixArray sa(S.substr(0, N / 8));
+  run("SA build (kasai) ", [&]
+      { SuffixArray t(S.substr(0, N / 8)); return accumulate(t.lcp.begin(), t.lcp.end(), 0LL); });
+  run("SA lower_upper x1000", [&]
+      {
+        long long c = 0;
+        for (int q = 0; q < 1000; ++q)
+        {
+          auto [l, r] = sa.lower_upper(P.substr(0, 2000 + q));
+          c += r - l;
+        }
+        return c; });
+}
@@ -8,6 +8,10 @@
     - 全回文部分文字列総数         | O(N)  ※Σ d1 + Σ d2
     - 区間 [l,r] が回文か判定       | O(1)  ※半径と中心で比較
     - 最長回文区間の開始/長さ列挙   | O(N)
+    - PalindromeIndex (1 パス版)    | 構築 O(N)  ※longest 用ブロックも構築時に作る
+        is_pal(l, r)                | O(1)  ※奇偶の場合分け不要
+        longest(l, r) 区間内最長回文 | O(B log N)  (B = 256)
+        is_pal_batch (先読み付き) / longest_batch | 上と同じ
 
   ◆ 主要関数
       manacher(s) -> pair<vector<int>, vector<int>>
@@ -15,6 +19,8 @@
               (長さ = 2*d1[i]-1)
         d2 : 各 i を右側中心とする **偶数**長回文の半径
               (長さ = 2*d2[i])
+      PalindromeIndex<Rad = uint32_t>(s)   ※manacher_fused(s) も同じ
+        len(c) : 両端の和が c (0 <= c <= 2N-2) となる最長回文の長さ
 
   ◆ 典型用法
       auto [d1, d2] = manacher(S);
@@ -22,6 +28,10 @@
       for (int i = 0; i < (int)S.size(); ++i) {
           best = max({best, 2*d1[i]-1, 2*d2[i]});
       }
+      PalindromeIndex<> pi(S);               // uint16_t ならメモリ約半分 (長い回文が少なければ)
+      bool ok = pi.is_pal(l, r);             // 閉区間 [l,r]
+      auto [st, L] = pi.longest(l, r);       // [l,r] 内の最長回文
+      // 以下は manacher の d1/d2 で直接判定する場合
       // 区間 [l,r] が回文？
       int len = r - l + 1, c, rad;
       if (len & 1) {                         // 奇数長
@@ -37,6 +47,7 @@
 
 #pragma once
 #include <bits/stdc++.h>
+#include "LCE.cpp"
 using namespace std;
 
 /*------------------------------------------------------------
@@ -56,8 +67,7 @@ pair<vector<int>, vector<int>> manacher(const Seq &s)
   for (int i = 0, l = 0, r = -1; i < n; ++i)
   {
     int k = (i > r) ? 1 : min(d1[l + r - i], r - i + 1);
-    while (0 <= i - k && i + k < n && s[i - k] == s[i + k])
-      ++k;
+    k += lce_mirror(s, i - k, i + k, min(i - k + 1, n - i - k));
     d1[i] = k;
     if (i + k - 1 > r)
     {
@@ -70,8 +80,7 @@ pair<vector<int>, vector<int>> manacher(const Seq &s)
   for (int i = 0, l = 0, r = -1; i < n; ++i)
   {
     int k = (i > r) ? 0 : min(d2[l + r - i + 1], r - i + 1);
-    while (0 <= i - k - 1 && i + k < n && s[i - k - 1] == s[i + k])
-      ++k;
+    k += lce_mirror(s, i - k - 1, i + k, min(i - k, n - i - k));
     d2[i] = k;
     if (i + k - 1 > r)
     {
@@ -82,13 +91,276 @@ pair<vector<int>, vector<int>> manacher(const Seq &s)
   return {d1, d2};
 }
 
-int main()
+/*------------------------------------------------------------
+  PalindromeIndex<Rad>
+    t = # s0 # s1 # ... # (長さ 2N+1) 上の Manacher を 1 パスで回し、
+    外側の # 2 つを除いた 2N-1 個の中心 c について
+      len(c) = i + j = c を満たす回文 [i, j] の最大長
+    を保持する (t は作らず、位置の偶奇で区切り / 文字を判別)。
+      c 偶数 : 文字 c/2 が中心      len = 2*d1[c/2] - 1
+      c 奇数 : c/2 と c/2+1 の間    len = 2*d2[c/2+1]   (0 もあり)
+    Rad = uint32_t (8N byte) / uint16_t (4N byte + 下記)。
+    uint16_t では 65535 以上の長さだけを big に逃がす。big は中心の昇順に
+    長さだけを並べ、何番目かは 64 中心ごとのビット列 + 累積個数で数える
+    (中心あたり +0.19 byte、逃がした中心 1 つにつき +4 byte)。
+    ※最悪 (同じ文字の連続など長い回文ばかりの入力) は全中心が逃げて
+      約 12.4N byte と uint32_t より大きくなる。長い回文が多い入力では uint32_t を使うこと。
+------------------------------------------------------------*/
+template <class Rad = uint32_t>
+struct PalindromeIndex
+{
+  static constexpr int CAP = (int)min<long long>(numeric_limits<Rad>::max(), INT_MAX);
+  static constexpr int B = 256; // 区間最長用のブロック長
+
+  int n = 0;
+  vector<Rad> rad;             // len(c) (CAP 以上は CAP)
+  vector<int> big;             // len(c) >= CAP の中心の長さ (中心の昇順)
+  vector<uint64_t> spill;      // spill[c/64] の bit c%64 : 中心 c が big にある
+  vector<int> spill_before;    // spill_before[c/64] : ブロック c/64 より前にある big の個数
+  vector<vector<int>> blk;     // blk[k][b] : ブロック b .. b+2^k-1 で len 最大の中心
+
+  PalindromeIndex() = default;
+  template <class Seq>
+  explicit PalindromeIndex(const Seq &s) { build(s); }
+
+  template <class Seq>
+  void build(const Seq &s)
+  {
+    n = (int)s.size();
+    rad.assign(max(0, 2 * n - 1), 0);
+    big.clear();
+    if constexpr (CAP < INT_MAX)
+    {
+      spill.assign((rad.size() + 63) / 64, 0);
+      spill_before.assign(spill.size(), 0);
+    }
+    // t 上の位置 k = c + 1, t[k-d+1 .. k+d-1] が回文となる最大の d (len = d - 1)
+    for (int k = 1, l = 0, r = 0; k < 2 * n; ++k)
+    {
+      int d = (k >= r) ? 1 : min(len(l + r - k - 1) + 1, r - k + 1);
+      while (k - d >= 0 && k + d <= 2 * n)
+      {
+        if (!((k - d) & 1))
+        { // 区切り同士は常に一致
+          ++d;
+          continue;
+        }
+        int a = (k - d - 1) >> 1, b = (k + d - 1) >> 1, lim = min(a + 1, n - b);
+        int e = lce_mirror(s, a, b, lim);
+        d += 2 * e; // 文字 1 組ごとに区切りも 1 組伸びる
+        if (e < lim)
+          break;
+      }
+      set(k - 1, d - 1);
+      if (k + d - 1 > r)
+      {
+        l = k - d + 1;
+        r = k + d - 1;
+      }
+    }
+    build_blocks(); // longest 用 (rad を 1 回なめるだけ)
+  }
+
+  int size() const { return n; }
+
+  // rad と big (+ 索引) の byte 数 (longest 用ブロックは除く)
+  size_t memory_bytes() const
+  {
+    return rad.size() * sizeof(Rad) + big.size() * sizeof(int) + spill.size() * (sizeof(uint64_t) + sizeof(int));
+  }
+
+  // 中心 c (= 両端の和) の最長回文長
+  int len(int c) const
+  {
+    int v = rad[c];
+    if (v < CAP)
+      return v;
+    const uint64_t below = spill[c >> 6] & ((uint64_t(1) << (c & 63)) - 1);
+    return big[spill_before[c >> 6] + __builtin_popcountll(below)];
+  }
+
+  // 閉区間 [l, r] が回文か
+  bool is_pal(int l, int r) const { return len(l + r) >= r - l + 1; }
+
+  // 閉区間 [l, r] に含まれる最長回文 {開始位置, 長さ}   O(B log N)
+  //   長さ L 以上の回文がある ⇔ 中心 [2l+L-1, 2r-L+1] に len >= L のものがある
+  pair<int, int> longest(int l, int r) const
+  {
+    int lo = 1, hi = r - l + 1, best = l + l; // 長さ 1 は必ずある
+    while (lo < hi)
+    {
+      int L = (lo + hi + 1) >> 1, c = arg_max(2 * l + L - 1, 2 * r - L + 1);
+      if (len(c) >= L)
+      {
+        lo = L;
+        best = c;
+      }
+      else
+        hi = L - 1;
+    }
+    return {(best - lo + 1) >> 1, lo};
+  }
+
+  // まとめて判定。次のクエリの中心を先読みして巨大 N でのキャッシュミスを隠す
+  vector<char> is_pal_batch(const vector<pair<int, int>> &qs) const
+  {
+    constexpr int D = 16;
+    const int q = (int)qs.size();
+    vector<char> res(q);
+    for (int i = 0; i < q; ++i)
+    {
+      if (i + D < q)
+        __builtin_prefetch(rad.data() + qs[i + D].first + qs[i + D].second);
+      res[i] = is_pal(qs[i].first, qs[i].second);
+    }
+    return res;
+  }
+
+  vector<pair<int, int>> longest_batch(const vector<pair<int, int>> &qs) const
+  {
+    vector<pair<int, int>> res;
+    res.reserve(qs.size());
+    for (auto [l, r] : qs)
+      res.push_back(longest(l, r));
+    return res;
+  }
+
+private:
+  void set(int c, int v)
+  {
+    // build は c を昇順に 1 回ずつ set するので、big は末尾に足すだけでよい
+    if constexpr (CAP < INT_MAX)
+      if ((c & 63) == 0)
+        spill_before[c >> 6] = (int)big.size();
+    if (v >= CAP)
+    {
+      rad[c] = (Rad)CAP;
+      spill[c >> 6] |= uint64_t(1) << (c & 63);
+      big.push_back(v);
+    }
+    else
+      rad[c] = (Rad)v;
+  }
+
+  int better(int a, int b) const { return len(a) >= len(b) ? a : b; }
+
+  // [a, b] で len 最大の中心 (同長なら左)
+  int scan(int a, int b) const
+  {
+    int arg = a, v = len(a);
+    for (int c = a + 1; c <= b; ++c)
+      if (int w = len(c); w > v)
+      {
+        arg = c;
+        v = w;
+      }
+    return arg;
+  }
+
+  void build_blocks()
+  {
+    const int m = (int)rad.size(), nb = (m + B - 1) / B;
+    blk.assign(1, vector<int>(nb));
+    for (int b = 0; b < nb; ++b)
+      blk[0][b] = scan(b * B, min(m, (b + 1) * B) - 1);
+    for (int k = 1; (1 << k) <= nb; ++k)
+    {
+      blk.emplace_back(nb - (1 << k) + 1);
+      for (int b = 0; b + (1 << k) <= nb; ++b)
+        blk[k][b] = better(blk[k - 1][b], blk[k - 1][b + (1 << (k - 1))]);
+    }
+  }
+
+  // 中心 [lo, hi] で len 最大のもの
+  int arg_max(int lo, int hi) const
+  {
+    int bl = lo / B, br = hi / B;
+    if (bl == br)
+      return scan(lo, hi);
+    int arg = better(scan(lo, bl * B + B - 1), scan(br * B, hi));
+    if (bl + 1 < br)
+    {
+      int k = __lg(br - bl - 1);
+      arg = better(arg, better(blk[k][bl + 1], blk[k][br - (1 << k)]));
+    }
+    return arg;
+  }
+};
+
+// 1 パス版 : manacher(s) と同じ情報を長さ 2N-1 の配列 1 本で返す
+template <class Rad = uint32_t, class Seq>
+PalindromeIndex<Rad> manacher_fused(const Seq &s) { return PalindromeIndex<Rad>(s); }
+
+/*--------------------- benchmark / demo ---------------------*/
+// 入力が無ければ N = 10^8 (引数で変更可) で manacher と PalindromeIndex を比較
+#ifndef MANACHER_NO_DEMO
+template <class T>
+struct RadTag
+{
+  using type = T;
+};
+
+void bench_manacher(int N)
+{
+  using clk = chrono::steady_clock;
+  mt19937 rng(1);
+  string S(N, 'a');
+  for (auto &c : S)
+    c = char('a' + rng() % 2);
+  auto ms = [](auto d)
+  { return chrono::duration<double, milli>(d).count(); };
+
+  vector<pair<int, int>> qs(1 << 22);
+  for (auto &[l, r] : qs)
+  {
+    l = rng() % N;
+    r = min(N - 1, l + (int)(rng() % 16));
+  }
+  long long sum1 = 0, sum2 = 0;
+  {
+    auto t0 = clk::now();
+    auto [d1, d2] = manacher(S);
+    auto t1 = clk::now();
+    for (auto [l, r] : qs)
+    { // ヘッダの奇偶場合分けそのまま
+      int len = r - l + 1;
+      sum1 += (len & 1) ? d1[(l + r) >> 1] >= (len + 1) / 2 : d2[(l + r + 1) >> 1] >= len / 2;
+    }
+    auto t2 = clk::now();
+    cout << "manacher          build " << ms(t1 - t0) << " ms  " << 8.0 * N / (1 << 20) << " MiB  is_pal "
+         << ms(t2 - t1) * 1e6 / qs.size() << " ns/q\n";
+  }
+  auto run = [&](auto tag, const char *name)
+  {
+    using Rad = typename decltype(tag)::type;
+    auto t0 = clk::now();
+    PalindromeIndex<Rad> pi(S);
+    auto t1 = clk::now();
+    auto res = pi.is_pal_batch(qs);
+    auto t2 = clk::now();
+    sum2 = accumulate(res.begin(), res.end(), 0LL);
+    auto t3 = clk::now();
+    auto lq = pi.longest_batch(vector<pair<int, int>>(qs.begin(), qs.begin() + 100000));
+    auto t4 = clk::now();
+    cout << name << " build " << ms(t1 - t0) << " ms  " << (double)pi.memory_bytes() / (1 << 20)
+         << " MiB  is_pal " << ms(t2 - t1) * 1e6 / qs.size() << " ns/q  longest "
+         << ms(t4 - t3) * 1e3 / lq.size() << " us/q" << (sum1 == sum2 ? "" : "  (MISMATCH)") << '\n';
+  };
+  run(RadTag<uint32_t>{}, "PalindromeIndex32");
+  run(RadTag<uint16_t>{}, "PalindromeIndex16");
+}
+
+int main(int argc, char **argv)
 {
   ios::sync_with_stdio(false);
   cin.tie(nullptr);
 
   string S; // 例: "abacdfgdcaba"
-  cin >> S;
+  if (!(cin >> S))
+  {
+    bench_manacher(argc >= 2 ? atoi(argv[1]) : 100000000);
+    return 0;
+  }
 
   auto [d1, d2] = manacher(S);
 
@@ -108,4 +380,10 @@ int main()
     }
   }
   cout << "Longest palindrome: " << S.substr(best_l, best_len) << '\n';
+
+  // 同じことを PalindromeIndex で (区間指定版)
+  PalindromeIndex<> pi(S);
+  auto [l, len] = pi.longest(0, (int)S.size() - 1);
+  cout << "Longest palindrome: " << S.substr(l, len) << "  is_pal=" << pi.is_pal(l, l + len - 1) << '\n';
 }
+#endif
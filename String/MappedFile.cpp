@@ -0,0 +1,67 @@
+/************************************************************
+  MappedFile  –  ファイルを mmap して読み取り専用 string_view で扱う
+  ----------------------------------------------------------
+  ◆ できること
+    - open(path)  : ファイル全体を読み取り専用で mmap (失敗時 false)
+    - view()      : 先頭からの string_view (コピー無し)
+    - デストラクタ / close() で munmap
+    ※ POSIX (Linux / macOS) 専用
+
+  ◆ 典型用法
+      MappedFile f;
+      if (!f.open("huge.log")) { ... }
+      string_view T = f.view();      // 20 GB でもコピーしない
+************************************************************/
+
+#pragma once
+#include <bits/stdc++.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+using namespace std;
+
+struct MappedFile
+{
+  const char *data = nullptr;
+  size_t size = 0;
+
+  MappedFile() = default;
+  explicit MappedFile(const string &path) { open(path); }
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+  ~MappedFile() { close(); }
+
+  bool open(const string &path)
+  {
+    close();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+      return false;
+    struct stat st;
+    bool ok = fstat(fd, &st) == 0;
+    if (ok && st.st_size > 0)
+    {
+      void *p = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      ok = p != MAP_FAILED;
+      if (ok)
+      {
+        data = (const char *)p;
+        size = (size_t)st.st_size;
+        madvise(p, size, MADV_SEQUENTIAL);
+      }
+    }
+    ::close(fd); // mmap 後は fd が無くても参照できる
+    return ok;
+  }
+
+  void close()
+  {
+    if (data)
+      munmap((void *)data, size);
+    data = nullptr;
+    size = 0;
+  }
+
+  string_view view() const { return {data, size}; }
+};
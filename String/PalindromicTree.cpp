@@ -0,0 +1,152 @@
+/************************************************************
+  Palindromic Tree (eertree)  –  末尾追加しながら回文を管理
+  ----------------------------------------------------------
+  ◆ できること (N = 追加済み長)           | 時間計算量
+    - 1 文字追加 append(c)               | 償却 O(1) ※遷移探索 O(子の数)
+    - 異なる回文部分列の個数 distinct()   | O(1)
+    - 最長回文接尾辞の長さ longest_suffix() | O(1)
+    - 回文接尾辞の個数 suffix_count()     | O(1)  ※累積で回文部分列の総数
+    - 各回文の出現回数 occurrences()      | O(ノード数)
+
+  ◆ 実装方針
+    * ノード 0 : 長さ -1 の仮想根, ノード 1 : 長さ 0 の根。
+      以降のノードが異なる回文 1 つずつに対応する。
+    * len / link / occ / depth と遷移 (連結リスト) をすべて配列で持つ。
+    * manacher と同じく要素型 T は == で比較できれば何でもよい
+      (char / int / long long など)。
+
+  ◆ 典型用法
+      PalindromicTree<char> pt;
+      long long total = 0;
+      for (char c : S) {
+          pt.append(c);
+          total += pt.suffix_count();          // これまでの回文部分列の総数
+          int L = pt.longest_suffix();         // S[i-L+1..i] が最長回文接尾辞
+      }
+      int kinds = pt.distinct();
+************************************************************/
+
+#pragma once
+#include <bits/stdc++.h>
+using namespace std;
+
+template <class T = char>
+struct PalindromicTree
+{
+  vector<T> s;                       // 追加済みの列
+  vector<int> len, link, depth;      // 回文長, 最長真回文接尾辞ノード, link を辿れる回数
+  vector<long long> occ;             // 最長回文接尾辞として現れた回数
+  vector<int> head;                  // ノード → 最初の子辺
+  vector<int> e_next, e_to;          // 子辺の連結リスト
+  vector<T> e_c;                     // 子辺の文字
+  int last = 1;                      // 現在の最長回文接尾辞ノード
+
+  PalindromicTree() { clear(); }
+
+  void clear()
+  {
+    s.clear();
+    len = {-1, 0};
+    link = {0, 0};
+    depth = {0, 0};
+    occ = {0, 0};
+    head = {-1, -1};
+    e_next.clear();
+    e_to.clear();
+    e_c.clear();
+    last = 1;
+  }
+
+  void reserve(int n)
+  {
+    s.reserve(n);
+    for (auto *v : {&len, &link, &depth, &head})
+      v->reserve(n + 2);
+    occ.reserve(n + 2);
+    e_next.reserve(n);
+    e_to.reserve(n);
+    e_c.reserve(n);
+  }
+
+  // 末尾に c を追加。新しい回文が生まれたら true
+  bool append(const T &c)
+  {
+    s.push_back(c);
+    int cur = suffix_with(last, c);
+    int w = child(cur, c);
+    if (w != -1)
+    {
+      ++occ[last = w];
+      return false;
+    }
+    w = (int)len.size();
+    len.push_back(len[cur] + 2);
+    link.push_back(len[w] == 1 ? 1 : child(suffix_with(link[cur], c), c));
+    depth.push_back(depth[link[w]] + 1);
+    occ.push_back(1);
+    head.push_back(-1);
+    e_next.push_back(head[cur]);
+    e_to.push_back(w);
+    e_c.push_back(c);
+    head[cur] = (int)e_to.size() - 1;
+    last = w;
+    return true;
+  }
+
+  int size() const { return (int)s.size(); }
+  int distinct() const { return (int)len.size() - 2; }
+  int longest_suffix() const { return len[last]; }
+  int suffix_count() const { return depth[last]; }
+
+  // ノード v の回文の出現回数 (全ノード分をまとめて返す)
+  vector<long long> occurrences() const
+  {
+    vector<long long> res = occ;
+    for (int v = (int)len.size() - 1; v >= 2; --v)
+      res[link[v]] += res[v]; // link は常に自分より前に作られる
+    return res;
+  }
+
+private:
+  // v から link を辿り、c の直前で回文となる (c X c が作れる) ノードを返す
+  int suffix_with(int v, const T &c) const
+  {
+    const int i = (int)s.size() - 1;
+    while (true)
+    {
+      int j = i - len[v] - 1;
+      if (j >= 0 && s[j] == c)
+        return v;
+      v = link[v];
+    }
+  }
+
+  int child(int v, const T &c) const
+  {
+    for (int e = head[v]; e != -1; e = e_next[e])
+      if (e_c[e] == c)
+        return e_to[e];
+    return -1;
+  }
+};
+
+int main()
+{
+  ios::sync_with_stdio(false);
+  cin.tie(nullptr);
+
+  string S; // 例: "abacaba"
+  cin >> S;
+
+  PalindromicTree<char> pt;
+  pt.reserve((int)S.size());
+  long long total = 0;
+  for (int i = 0; i < (int)S.size(); ++i)
+  {
+    pt.append(S[i]);
+    total += pt.suffix_count();
+    int L = pt.longest_suffix();
+    cout << "i=" << i << " distinct=" << pt.distinct() << " total=" << total
+         << " longest_suffix=" << S.substr(i - L + 1, L) << '\n';
+  }
+}
@@ -0,0 +1,686 @@
+/************************************************************
+  Radix Trie (ART 風)  –  任意 byte 列の集合を経路圧縮 + 可変幅ノードで管理
+  ----------------------------------------------------------
+  ◆ できること (L = キー長)                 | 時間計算量
+    - 挿入 insert(s)  (新規なら true)        | O(L)
+    - 完全一致判定 contains(s)              | O(L)
+    - 接頭辞を持つキーの個数 prefix_count(p) | O(L)
+    - 削除 erase(s)  (あれば true)          | O(L)
+    キーは string_view。'\0' を含む任意の byte 列でよい (集合なので重複は 1 個)
+
+  ◆ 実装方針 (Adaptive Radix Tree)
+    * 各ノードは圧縮された接頭辞を持ち、分岐の無い一本道は 1 ノードに
+      まとまる。葉も「子 0 個の内部ノード」。接頭辞は 8 byte 以下ならノード内に
+      直接、長ければ bytes プール上の区間として持つ (1 段あたりの参照先を減らす)。
+    * 子の入れ物は子の数に応じて 4 / 16 / 48 / 256 の 4 種類を使い分け、
+      あふれたら 1 段大きく、減ったら 1 段小さく作り直す。
+        N4  : key[4]  + child[4]     (線形探索)
+        N16 : key[16] + child[16]    (SSE2 で 16 byte 一括比較)
+        N48 : index[256] + child[48]
+        N256: child[256]
+    * ノード・入れ物はすべて種類ごとのフラット配列 + 空きリスト (ポインタ無し)。
+    * 削除で子が 1 つになった非終端ノードは子と併合し、経路圧縮を保つ。
+    * 子は byte 順に並べていない (辞書順列挙は提供しない)。
+    * bytes プールは追記のみで、削除・併合で不要になった区間は回収しない
+      (削除が多いなら作り直す)。プールは 4 GiB 未満。
+
+  ◆ 典型用法
+      RadixTrie rt;
+      rt.insert("https://example.com/a");
+      if (rt.contains(url)) ...
+      int k = rt.prefix_count("https://example.com/");
+      rt.erase(url);
+************************************************************/
+
+#pragma once
+#include <bits/stdc++.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+using namespace std;
+
+struct RadixTrie
+{
+  enum Kind : uint8_t
+  {
+    LEAF,
+    N4,
+    N16,
+    N48,
+    N256
+  };
+  struct Node
+  {
+    union
+    {
+      char inl[8] = {}; // pre_len <= 8 : 接頭辞そのもの
+      uint32_t pre_off;   // pre_len >  8 : bytes[pre_off, pre_off + pre_len)
+    };
+    uint32_t pre_len = 0;
+    uint32_t cnt = 0;  // 部分木のキー数
+    uint32_t body = 0; // 子の入れ物の番号 (kind ごとの配列)
+    uint16_t nchild = 0;
+    Kind kind = LEAF;
+    uint8_t end = 0; // ここで終わるキーがあるか
+  };
+  struct Body4
+  {
+    uint8_t key[4];
+    uint32_t child[4];
+  };
+  struct Body16
+  {
+    uint8_t key[16];
+    uint32_t child[16];
+  };
+  struct Body48
+  {
+    uint8_t index[256]; // byte → child の番号 + 1 (0 は無し)
+    uint32_t child[48];
+  };
+  struct Body256
+  {
+    uint32_t child[256]; // 0 は無し (根 = 0 は子にならない)
+  };
+
+  vector<Node> node;
+  vector<Body4> b4;
+  vector<Body16> b16;
+  vector<Body48> b48;
+  vector<Body256> b256;
+  vector<uint32_t> free_node, free_b[5];
+  string bytes; // 接頭辞プール (追記のみ)
+
+  RadixTrie() { clear(); }
+
+  void clear()
+  {
+    node.assign(1, Node{});
+    b4.clear();
+    b16.clear();
+    b48.clear();
+    b256.clear();
+    free_node.clear();
+    for (auto &f : free_b)
+      f.clear();
+    bytes.clear();
+  }
+
+  int size() const { return (int)node[0].cnt; }
+
+  size_t memory_bytes() const
+  {
+    return node.capacity() * sizeof(Node) + b4.capacity() * sizeof(Body4) + b16.capacity() * sizeof(Body16) +
+           b48.capacity() * sizeof(Body48) + b256.capacity() * sizeof(Body256) + bytes.capacity();
+  }
+
+  bool insert(string_view s)
+  {
+    uint32_t path[64];
+    vector<uint32_t> path_big;
+    int np = 0;
+    auto push = [&](uint32_t v)
+    {
+      if (np < 64)
+        path[np++] = v;
+      else
+        path_big.push_back(v);
+    };
+    uint32_t v = 0, parent = UINT32_MAX;
+    uint8_t edge = 0;
+    size_t d = 0;
+    while (true)
+    {
+      const Node &nv = node[v];
+      const size_t m = common(nv, s, d);
+      if (m < nv.pre_len)
+      { // 接頭辞の途中で分かれる → v の上に分岐ノード u を挟む
+        uint32_t u = new_node();
+        Node &nu = node[u], &ov = node[v];
+        const uint8_t c = (uint8_t)pre(ov)[m];
+        if (m > INL) // 長い接頭辞は同じ区間を共有
+          nu.pre_off = ov.pre_off, nu.pre_len = (uint32_t)m;
+        else
+          set_prefix(nu, pre(ov), m);
+        const size_t rest = ov.pre_len - m - 1;
+        if (rest > INL)
+          ov.pre_off += (uint32_t)m + 1, ov.pre_len = (uint32_t)rest;
+        else
+        {
+          char tmp[INL];
+          memcpy(tmp, pre(ov) + m + 1, rest);
+          set_prefix(ov, tmp, rest);
+        }
+        nu.cnt = ov.cnt;
+        add_child(u, c, v);
+        replace_child(parent, edge, u);
+        v = u;
+      }
+      push(v);
+      d += node[v].pre_len;
+      if (d == s.size())
+      {
+        if (node[v].end)
+          return false;
+        node[v].end = 1;
+        break;
+      }
+      const uint8_t c = (uint8_t)s[d];
+      uint32_t w = find_child(v, c);
+      if (w == 0)
+      {
+        uint32_t leaf = new_node();
+        Node &nl = node[leaf];
+        set_prefix(nl, s.data() + d + 1, s.size() - d - 1);
+        nl.cnt = 1;
+        nl.end = 1;
+        add_child(v, c, leaf);
+        break;
+      }
+      parent = v;
+      edge = c;
+      v = w;
+      ++d;
+    }
+    for (int i = 0; i < np; ++i)
+      ++node[path[i]].cnt;
+    for (uint32_t x : path_big)
+      ++node[x].cnt;
+    return true;
+  }
+
+  bool contains(string_view s) const
+  {
+    uint32_t v = 0;
+    size_t d = 0;
+    while (true)
+    {
+      const Node &nv = node[v];
+      if (s.size() - d < nv.pre_len || memcmp(s.data() + d, pre(nv), nv.pre_len) != 0)
+        return false;
+      d += nv.pre_len;
+      if (d == s.size())
+        return nv.end;
+      if ((v = find_child(v, (uint8_t)s[d++])) == 0)
+        return false;
+    }
+  }
+
+  // 接頭辞 p を持つキーの個数
+  int prefix_count(string_view p) const
+  {
+    uint32_t v = 0;
+    size_t d = 0;
+    while (true)
+    {
+      const Node &nv = node[v];
+      const size_t k = min<size_t>(nv.pre_len, p.size() - d);
+      if (memcmp(p.data() + d, pre(nv), k) != 0)
+        return 0;
+      if (d + k == p.size())
+        return (int)nv.cnt; // p が v の接頭辞の途中 (または直後) で尽きた
+      d += k;
+      if ((v = find_child(v, (uint8_t)p[d++])) == 0)
+        return 0;
+    }
+  }
+
+  bool erase(string_view s)
+  {
+    // 経路 (ノード, 親, 親からの辺) を記録しながら降りる
+    struct Step
+    {
+      uint32_t v, parent;
+      uint8_t edge;
+    };
+    vector<Step> path;
+    uint32_t v = 0, parent = UINT32_MAX;
+    uint8_t edge = 0;
+    size_t d = 0;
+    while (true)
+    {
+      const Node &nv = node[v];
+      if (s.size() - d < nv.pre_len || memcmp(s.data() + d, pre(nv), nv.pre_len) != 0)
+        return false;
+      path.push_back({v, parent, edge});
+      d += nv.pre_len;
+      if (d == s.size())
+        break;
+      parent = v;
+      edge = (uint8_t)s[d++];
+      if ((v = find_child(parent, edge)) == 0)
+        return false;
+    }
+    if (!node[v].end)
+      return false;
+    node[v].end = 0;
+    for (auto &st : path)
+      --node[st.v].cnt;
+
+    // 後始末 : 空になった葉を外し、子 1 個の非終端ノードは子と併合
+    const Step last = path.back();
+    uint32_t x = v;
+    if (x != 0 && node[x].nchild == 0)
+    {
+      remove_child(last.parent, last.edge);
+      free_node.push_back(x);
+      x = last.parent;
+      if (path.size() >= 2)
+        path.pop_back();
+    }
+    const Step &at = path.back(); // x の位置
+    if (x != 0 && !node[x].end && node[x].nchild == 1)
+      merge_with_child(x, at.parent, at.edge);
+    return true;
+  }
+
+private:
+  static constexpr size_t INL = 8;
+
+  const char *pre(const Node &nv) const { return nv.pre_len <= INL ? nv.inl : bytes.data() + nv.pre_off; }
+
+  // p は bytes の中を指していてはならない
+  void set_prefix(Node &nv, const char *p, size_t len)
+  {
+    nv.pre_len = (uint32_t)len;
+    if (len <= INL)
+      memcpy(nv.inl, p, len);
+    else
+    {
+      nv.pre_off = (uint32_t)bytes.size();
+      bytes.append(p, len);
+    }
+  }
+
+  uint32_t new_node()
+  {
+    if (!free_node.empty())
+    {
+      uint32_t v = free_node.back();
+      free_node.pop_back();
+      node[v] = Node{};
+      return v;
+    }
+    node.emplace_back();
+    return (uint32_t)node.size() - 1;
+  }
+
+  template <class Vec>
+  uint32_t alloc(Vec &pool, int kind)
+  {
+    auto &fl = free_b[kind];
+    if (!fl.empty())
+    {
+      uint32_t b = fl.back();
+      fl.pop_back();
+      pool[b] = {};
+      return b;
+    }
+    pool.emplace_back();
+    return (uint32_t)pool.size() - 1;
+  }
+
+  // s[d..] と v の接頭辞の一致長
+  size_t common(const Node &nv, string_view s, size_t d) const
+  {
+    const size_t lim = min<size_t>(nv.pre_len, s.size() - d);
+    const char *a = pre(nv), *b = s.data() + d;
+    size_t k = 0;
+    while (k < lim && a[k] == b[k])
+      ++k;
+    return k;
+  }
+
+  // 子が無ければ 0
+  uint32_t find_child(uint32_t v, uint8_t c) const
+  {
+    const Node &nv = node[v];
+    switch (nv.kind)
+    {
+    case LEAF:
+      return 0;
+    case N4:
+    {
+      const Body4 &b = b4[nv.body];
+      for (int i = 0; i < nv.nchild; ++i)
+        if (b.key[i] == c)
+          return b.child[i];
+      return 0;
+    }
+    case N16:
+    {
+      const Body16 &b = b16[nv.body];
+#if defined(__SSE2__)
+      __m128i k = _mm_loadu_si128((const __m128i *)b.key);
+      unsigned mask = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(k, _mm_set1_epi8((char)c))) &
+                      ((1u << nv.nchild) - 1);
+      return mask ? b.child[__builtin_ctz(mask)] : 0;
+#else
+      for (int i = 0; i < nv.nchild; ++i)
+        if (b.key[i] == c)
+          return b.child[i];
+      return 0;
+#endif
+    }
+    case N48:
+    {
+      const Body48 &b = b48[nv.body];
+      return b.index[c] ? b.child[b.index[c] - 1] : 0;
+    }
+    default:
+      return b256[nv.body].child[c];
+    }
+  }
+
+  // v の子を列挙 f(byte, child)
+  template <class F>
+  void for_each_child(uint32_t v, F f) const
+  {
+    const Node &nv = node[v];
+    switch (nv.kind)
+    {
+    case LEAF:
+      return;
+    case N4:
+      for (int i = 0; i < nv.nchild; ++i)
+        f(b4[nv.body].key[i], b4[nv.body].child[i]);
+      return;
+    case N16:
+      for (int i = 0; i < nv.nchild; ++i)
+        f(b16[nv.body].key[i], b16[nv.body].child[i]);
+      return;
+    case N48:
+      for (int c = 0; c < 256; ++c)
+        if (uint8_t k = b48[nv.body].index[c])
+          f((uint8_t)c, b48[nv.body].child[k - 1]);
+      return;
+    default:
+      for (int c = 0; c < 256; ++c)
+        if (uint32_t w = b256[nv.body].child[c])
+          f((uint8_t)c, w);
+    }
+  }
+
+  // 入れ物を kind に作り直す (子はそのまま移す)
+  void rebuild(uint32_t v, Kind kind)
+  {
+    vector<pair<uint8_t, uint32_t>> ch;
+    ch.reserve(node[v].nchild);
+    for_each_child(v, [&](uint8_t c, uint32_t w)
+                   { ch.emplace_back(c, w); });
+    if (node[v].kind != LEAF)
+      free_b[node[v].kind].push_back(node[v].body);
+    uint32_t b = 0;
+    switch (kind)
+    {
+    case LEAF:
+      break;
+    case N4:
+      b = alloc(b4, N4);
+      for (int i = 0; i < (int)ch.size(); ++i)
+        b4[b].key[i] = ch[i].first, b4[b].child[i] = ch[i].second;
+      break;
+    case N16:
+      b = alloc(b16, N16);
+      for (int i = 0; i < (int)ch.size(); ++i)
+        b16[b].key[i] = ch[i].first, b16[b].child[i] = ch[i].second;
+      break;
+    case N48:
+      b = alloc(b48, N48);
+      for (int i = 0; i < (int)ch.size(); ++i)
+        b48[b].index[ch[i].first] = (uint8_t)(i + 1), b48[b].child[i] = ch[i].second;
+      break;
+    default:
+      b = alloc(b256, N256);
+      for (auto [c, w] : ch)
+        b256[b].child[c] = w;
+    }
+    node[v].kind = kind;
+    node[v].body = b;
+  }
+
+  void add_child(uint32_t v, uint8_t c, uint32_t w)
+  {
+    static constexpr int cap[5] = {0, 4, 16, 48, 256};
+    Node &nv = node[v];
+    if (nv.nchild == cap[nv.kind])
+      rebuild(v, Kind(nv.kind + 1));
+    Node &n2 = node[v];
+    const int i = n2.nchild++;
+    switch (n2.kind)
+    {
+    case N4:
+      b4[n2.body].key[i] = c, b4[n2.body].child[i] = w;
+      break;
+    case N16:
+      b16[n2.body].key[i] = c, b16[n2.body].child[i] = w;
+      break;
+    case N48:
+    {
+      Body48 &b = b48[n2.body];
+      int slot = 0;
+      while (b.child[slot]) // 空いている child の番号
+        ++slot;
+      b.child[slot] = w;
+      b.index[c] = (uint8_t)(slot + 1);
+      break;
+    }
+    default:
+      b256[n2.body].child[c] = w;
+    }
+  }
+
+  void replace_child(uint32_t v, uint8_t c, uint32_t w)
+  {
+    if (v == UINT32_MAX)
+      return;
+    Node &nv = node[v];
+    switch (nv.kind)
+    {
+    case N4:
+      for (int i = 0; i < nv.nchild; ++i)
+        if (b4[nv.body].key[i] == c)
+          b4[nv.body].child[i] = w;
+      break;
+    case N16:
+      for (int i = 0; i < nv.nchild; ++i)
+        if (b16[nv.body].key[i] == c)
+          b16[nv.body].child[i] = w;
+      break;
+    case N48:
+      b48[nv.body].child[b48[nv.body].index[c] - 1] = w;
+      break;
+    default:
+      b256[nv.body].child[c] = w;
+    }
+  }
+
+  void remove_child(uint32_t v, uint8_t c)
+  {
+    Node &nv = node[v];
+    const int last = nv.nchild - 1;
+    switch (nv.kind)
+    {
+    case N4:
+    {
+      Body4 &b = b4[nv.body];
+      for (int i = 0; i <= last; ++i)
+        if (b.key[i] == c)
+        {
+          b.key[i] = b.key[last], b.child[i] = b.child[last];
+          break;
+        }
+      break;
+    }
+    case N16:
+    {
+      Body16 &b = b16[nv.body];
+      for (int i = 0; i <= last; ++i)
+        if (b.key[i] == c)
+        {
+          b.key[i] = b.key[last], b.child[i] = b.child[last];
+          break;
+        }
+      break;
+    }
+    case N48:
+    {
+      Body48 &b = b48[nv.body];
+      b.child[b.index[c] - 1] = 0;
+      b.index[c] = 0;
+      break;
+    }
+    default:
+      b256[nv.body].child[c] = 0;
+    }
+    --nv.nchild;
+    // 縮小 (行き来を避けるため容量より少し小さくなってから)
+    if (nv.kind == N256 && nv.nchild <= 40)
+      rebuild(v, N48);
+    else if (nv.kind == N48 && nv.nchild <= 12)
+      rebuild(v, N16);
+    else if (nv.kind == N16 && nv.nchild <= 3)
+      rebuild(v, N4);
+    else if (nv.kind == N4 && nv.nchild == 0)
+      rebuild(v, LEAF);
+  }
+
+  // 非終端で子が 1 個の x を子 y と併合し、y を x の位置へ
+  void merge_with_child(uint32_t x, uint32_t parent, uint8_t edge)
+  {
+    uint8_t c = 0;
+    uint32_t y = 0;
+    for_each_child(x, [&](uint8_t cc, uint32_t w)
+                   { c = cc, y = w; });
+    string cat(pre(node[x]), node[x].pre_len);
+    cat.push_back((char)c);
+    cat.append(pre(node[y]), node[y].pre_len);
+    set_prefix(node[y], cat.data(), cat.size());
+    rebuild(x, LEAF);
+    free_node.push_back(x);
+    replace_child(parent, edge, y);
+  }
+};
+
+/*--------------------- benchmark / demo ---------------------*/
+// 1. URL / バイナリ ID 風のキー (長い共通接頭辞) で unordered_set<string> と比較
+// 2. 'a'-'z' の語で既存の Trie と比較
+#ifndef RADIXTRIE_NO_DEMO
+#define TRIE_NO_DEMO
+#include "Trie.cpp"
+
+int main(int argc, char **argv)
+{
+  ios::sync_with_stdio(false);
+  cin.tie(nullptr);
+
+  const int N = argc >= 2 ? atoi(argv[1]) : 1000000;
+  mt19937 rng(1);
+  using clk = chrono::steady_clock;
+  auto ns = [&](auto d)
+  { return chrono::duration<double, nano>(d).count() / N; };
+
+  // 1. URL と 16 byte のバイナリ ID を半々
+  vector<string> keys(N), miss(N);
+  for (int i = 0; i < N; ++i)
+  {
+    string &k = keys[i];
+    if (i % 2)
+    {
+      k = "https://cdn" + to_string(rng() % 16) + ".example.com/assets/v" + to_string(rng() % 4) + "/";
+      for (int d = 0; d < 3; ++d)
+        k += "dir" + to_string(rng() % 32) + "/";
+      k += to_string(rng()) + ".png";
+    }
+    else
+    {
+      k.assign("\x00\x01ID", 4);
+      for (int b = 0; b < 12; ++b)
+        k.push_back(char(b < 2 ? rng() % 4 : rng() % 256));
+    }
+    miss[i] = keys[i];
+    miss[i].back() ^= 0x55; // ほぼすべて未登録
+  }
+
+  RadixTrie rt;
+  unordered_set<string> us;
+  size_t key_bytes = 0;
+  auto t0 = clk::now();
+  for (auto &k : keys)
+    rt.insert(k);
+  auto t1 = clk::now();
+  for (auto &k : keys)
+    us.insert(k);
+  auto t2 = clk::now();
+  long long a = 0, b = 0;
+  for (int i = 0; i < N; ++i)
+    a += rt.contains(keys[i]) + rt.contains(miss[i]);
+  auto t3 = clk::now();
+  for (int i = 0; i < N; ++i)
+    b += us.count(keys[i]) + us.count(miss[i]);
+  auto t4 = clk::now();
+  for (auto &k : us)
+    key_bytes += k.size() + 1;
+  // 下限の見積り : バケット + ノード (next, string, hash) + 16 byte を超える文字列本体
+  size_t us_bytes = us.bucket_count() * 8 + us.size() * (8 + sizeof(string) + 8);
+  for (auto &k : us)
+    us_bytes += k.size() > 15 ? k.size() + 1 : 0;
+  cout << "keys=" << rt.size() << " (" << key_bytes / 1048576.0 << " MiB raw)\n"
+       << "RadixTrie     " << rt.memory_bytes() / 1048576.0 << " MiB  insert " << ns(t1 - t0)
+       << " ns  contains(hit+miss) " << ns(t3 - t2) << " ns\n"
+       << "unordered_set " << us_bytes / 1048576.0 << " MiB  insert " << ns(t2 - t1) << " ns  contains(hit+miss) "
+       << ns(t4 - t3) << " ns  " << (a == b ? "" : "(MISMATCH)") << '\n';
+  auto t5 = clk::now();
+  long long c = rt.prefix_count("https://cdn3.example.com/assets/v1/") + rt.prefix_count(string_view("\x00\x01ID\x02", 5));
+  for (int i = 0; i < N; i += 2)
+    c += rt.erase(keys[i]);
+  auto t6 = clk::now();
+  for (int i = 0; i < N; i += 2)
+    us.erase(keys[i]);
+  auto t7 = clk::now();
+  bool ok = (int)us.size() == rt.size();
+  for (int i = 0; i < N && ok; ++i)
+    ok = rt.contains(keys[i]) == (bool)us.count(keys[i]);
+  cout << "erase half    RadixTrie " << ns(t6 - t5) * 2 << " ns  unordered_set " << ns(t7 - t6) * 2
+       << " ns  consistent: " << boolalpha << ok << "  (c=" << c << ")\n";
+
+  // 2. 'a'-'z' の語 (FrozenTrie のデモと同じ分布)
+  const string freq = "eeeeeeettttaaaaoooiiinnnssshhrrdllcumwfgypbvkjxqz";
+  vector<string> words(N), queries(N);
+  for (auto &w : words)
+  {
+    w.resize(3 + rng() % 12);
+    for (auto &ch : w)
+      ch = freq[rng() % freq.size()];
+  }
+  for (int i = 0; i < N; ++i)
+    queries[i] = rng() % 2 ? words[rng() % N] : words[rng() % N].substr(0, 2 + rng() % 4);
+  Trie tr;
+  RadixTrie rw;
+  auto s0 = clk::now();
+  for (auto &w : words)
+    tr.insert(w);
+  auto s1 = clk::now();
+  for (auto &w : words)
+    rw.insert(w);
+  auto s2 = clk::now();
+  long long x = 0, y = 0;
+  for (auto &q : queries)
+    x += tr.contains(q);
+  auto s3 = clk::now();
+  for (auto &q : queries)
+    y += rw.contains(q);
+  auto s4 = clk::now();
+  for (auto &q : queries)
+    x += tr.prefix_count(q) > 0;
+  auto s5 = clk::now();
+  for (auto &q : queries)
+    y += rw.prefix_count(q) > 0;
+  auto s6 = clk::now();
+  cout << "a-z words     Trie " << tr.tr.size() * sizeof(Trie::Node) / 1048576.0 << " MiB  insert " << ns(s1 - s0)
+       << " ns  contains " << ns(s3 - s2) << " ns  prefix_count " << ns(s5 - s4) << " ns\n"
+       << "              RadixTrie " << rw.memory_bytes() / 1048576.0 << " MiB  insert " << ns(s2 - s1)
+       << " ns  contains " << ns(s4 - s3) << " ns  prefix_count " << ns(s6 - s5) << " ns  "
+       << (x == y ? "" : "(MISMATCH)") << '\n';
+}
+#endif
@@ -11,11 +11,12 @@
     - 回文判定 (左右 hash 比較)       | O(1) / 区間
 
   ◆ 主要構造体
-      struct RollingHash {
-          RollingHash(string s, uint64_t base = FIXED);
+      struct RollingHash {                          // mod 2^61-1, base 乱択
+          RollingHash(const Seq &s);                // string / vector<int> ...
           uint64_t get(int l,int r) const;          // 半開区間 [l,r)
           bool     same(int l1,int r1,int l2,int r2) const;
       }
+      RollingHash64 : 旧 mod 2^64 版 (最速だが Thue–Morse 列で衝突)
 
   ◆ 典型用法
       RollingHash rh(S);                 // 前処理 O(N)
@@ -41,20 +42,118 @@
 using namespace std;
 
 /*------------------------------------------------------------
-  RollingHash  (single 64-bit mod 2^64 自然オーバーフロー版)
-    * 桁あふれをそのまま利用するため mod 計算が不要で速い
-    * 64 ビット衝突を嫌う場合は ↓ の DOUBLE_HASH を有効化
+  RollingHash  (mod 2^61-1, base は起動時に乱択)
+    * 乗算は 128 bit 積を 2^61 ≡ 1 で畳むだけなので % を使わない
+    * base は全インスタンス共通 (別インスタンス同士のハッシュも比較できる)
+      状態はインスタンスごとに持つので、複数同時に / 別スレッドで build してよい
+    * base^k の表は全インスタンスで共有し、必要な長さまで倍々に伸ばす
+      (伸ばす時は新しい表に差し替えるので、古い表を見ているインスタンスも安全)
+    * 要素型は char / int / long long など何でもよい (string, vector<int>, ...)
 ------------------------------------------------------------*/
 struct RollingHash
+{
+  using ull = unsigned long long;
+  static constexpr ull MOD = (1ull << 61) - 1;
+
+  static ull mul(ull a, ull b)
+  {
+    __uint128_t t = (__uint128_t)a * b;
+    ull x = (ull)(t >> 61) + ((ull)t & MOD);
+    return x >= MOD ? x - MOD : x;
+  }
+
+  static ull base()
+  {
+    static const ull b = []
+    {
+      mt19937_64 rng(random_device{}() ^ (ull)chrono::steady_clock::now().time_since_epoch().count());
+      return rng() % (MOD - (1 << 20)) + (1 << 20);
+    }();
+    return b;
+  }
+
+  // base^0 .. base^(n-1) 以上を含む共有表
+  static shared_ptr<const vector<ull>> powers(size_t n)
+  {
+    static mutex mtx;
+    static shared_ptr<const vector<ull>> table = make_shared<const vector<ull>>(1, 1);
+    lock_guard<mutex> lk(mtx);
+    if (table->size() < n)
+    {
+      auto next = make_shared<vector<ull>>(*table);
+      next->resize(max(n, 2 * table->size()));
+      for (size_t k = table->size(); k < next->size(); ++k)
+        (*next)[k] = mul((*next)[k - 1], base());
+      table = move(next);
+    }
+    return table;
+  }
+
+  // 要素 → [1, MOD) (0 にしないことで "a" と "\0a" を区別)
+  template <class T>
+  static ull code(const T &x)
+  {
+    if constexpr (sizeof(T) == 1)
+      return (ull)(unsigned char)x + 1;
+    else
+      return (ull)x % (MOD - 1) + 1;
+  }
+
+  shared_ptr<const vector<ull>> pow_table;
+  const ull *pw = nullptr; // pow_table->data()
+  vector<ull> pref;
+
+  RollingHash() = default;
+  template <class Seq>
+  explicit RollingHash(const Seq &s) { build(s); }
+
+  template <class Seq>
+  void build(const Seq &s)
+  {
+    const int n = (int)s.size();
+    pow_table = powers(n + 1);
+    pw = pow_table->data();
+    pref.resize(n + 1);
+    pref[0] = 0;
+    const ull b = base();
+    for (int i = 0; i < n; ++i)
+    {
+      ull x = mul(pref[i], b) + code(s[i]);
+      pref[i + 1] = x >= MOD ? x - MOD : x;
+    }
+  }
+
+  int size() const { return (int)pref.size() - 1; }
+
+  // 半開区間 [l,r) のハッシュ
+  ull get(int l, int r) const
+  {
+    ull x = pref[r] + MOD - mul(pref[l], pw[r - l]);
+    return x >= MOD ? x - MOD : x;
+  }
+
+  // 2 部分文字列 [l1,r1), [l2,r2) が一致するか
+  bool same(int l1, int r1, int l2, int r2) const
+  {
+    return (r1 - l1) == (r2 - l2) && get(l1, r1) == get(l2, r2);
+  }
+};
+
+/*------------------------------------------------------------
+  RollingHash64  (旧版 : mod 2^64 自然オーバーフロー)
+    * mod 計算が無く最速だが、Thue–Morse 列で base によらず衝突する
+      (ベンチマークの衝突例を参照)。入力を選べない場面専用
+------------------------------------------------------------*/
+struct RollingHash64
 {
   using ull = unsigned long long;
   static constexpr ull FIXED_BASE = 100000007ull; // 好きな奇数
-  static ull base;
+  ull base = FIXED_BASE;
 
   vector<ull> pow, pref;
-  RollingHash() = default;
+  RollingHash64() = default;
 
-  RollingHash(const string &s, ull b = FIXED_BASE) { build(s, b); }
+  RollingHash64(const string &s, ull b = FIXED_BASE) { build(s, b); }
 
   void build(const string &s, ull b = FIXED_BASE)
   {
@@ -82,7 +181,6 @@ struct RollingHash
     return (r1 - l1) == (r2 - l2) && get(l1, r1) == get(l2, r2);
   }
 };
-RollingHash::ull RollingHash::base = RollingHash::FIXED_BASE;
 
 /*----------- もし衝突耐性を高めたいなら二重ハッシュ ---------*/
 // #define DOUBLE_HASH
@@ -147,6 +245,146 @@ bool is_pal(const RollingHash &fwd, const RollingHash &rev, int l, int r, int N)
   return fwd.get(l, r) == rev.get(N - r, N - l);
 }
 
+/*------------------------------------------------------------
+  longest_common_substr / longest_repeated_substr_hash の下請け
+    * FlatHashIndex : ハッシュ値 → 位置の連結リスト の open addressing 表。
+      ハッシュが一致しても中身が違えば同じハッシュ値の次の位置を調べる
+      (衝突で偽陰性にならない)。二分探索の各ステップで使い回し、
+      消去は世代番号で O(1)。
+    * hash_windows  : 長さ L の全窓のハッシュをスレッド分割で計算。
+------------------------------------------------------------*/
+struct FlatHashIndex
+{
+  using ull = unsigned long long;
+  struct Slot
+  {
+    ull key;
+    int head; // >= 0 : 同じハッシュ値の位置の連結リストの先頭, < 0 : 位置 ~head の 1 つだけ
+    unsigned gen;
+  };
+  vector<Slot> slot;
+  vector<int> nxt; // nxt[pos] : 同じハッシュ値の次の位置 (-1 で終端)。2 つ目以降を足すときだけ書く
+  unsigned gen = 0;
+  int shift = 64;
+
+  // 位置 0..n-1 を入れる準備 (負荷率 3/4 以下)
+  void reset(int n)
+  {
+    size_t cap = 2;
+    while (cap * 3 < (size_t)n * 4)
+      cap <<= 1;
+    if (cap > slot.size())
+    {
+      slot.assign(cap, Slot{0, -1, 0});
+      gen = 0;
+      shift = 64 - __lg(cap);
+    }
+    if (++gen == 0)
+    {
+      for (auto &e : slot)
+        e.gen = 0;
+      gen = 1;
+    }
+    if ((int)nxt.size() < n)
+      nxt.resize(n);
+  }
+
+  // key の位置として pos を足す (同じ key の中で先頭になる)
+  void add(ull key, int pos) { push(slot[probe(key)], key, pos); }
+
+  // key の位置を新しく足した順に辿り、eq(pos) が真の最初の pos (無ければ -1)
+  //   ハッシュ衝突で中身が違っても、同じ key の他の位置を調べ続ける
+  template <class Eq>
+  int find(ull key, Eq &&eq) const
+  {
+    const Slot &e = slot[probe(key)];
+    return e.gen == gen ? scan(e, eq) : -1;
+  }
+
+  // find(key, eq) と同じだが、見つからなければ pos を足して -1 (表を 1 回だけ引く)
+  template <class Eq>
+  int find_or_add(ull key, int pos, Eq &&eq)
+  {
+    const size_t mask = slot.size() - 1;
+    for (size_t h = (key * 0x9E3779B97F4A7C15ull) >> shift;; h = (h + 1) & mask)
+    {
+      Slot &e = slot[h];
+      if (e.gen != gen)
+      {
+        e = Slot{key, ~pos, gen};
+        return -1;
+      }
+      if (e.key == key)
+      {
+        if (int p = scan(e, eq); p != -1)
+          return p;
+        push(e, key, pos);
+        return -1;
+      }
+    }
+  }
+
+private:
+  // key の入っている slot か、無ければ入れるべき空き slot
+  size_t probe(ull key) const
+  {
+    const size_t mask = slot.size() - 1;
+    size_t h = (key * 0x9E3779B97F4A7C15ull) >> shift;
+    while (slot[h].gen == gen && slot[h].key != key)
+      h = (h + 1) & mask;
+    return h;
+  }
+
+  void push(Slot &e, ull key, int pos)
+  {
+    if (e.gen != gen)
+    {
+      e = Slot{key, ~pos, gen}; // 1 つ目は nxt を書かない
+      return;
+    }
+    if (e.head < 0)
+      nxt[~e.head] = -1, e.head = ~e.head;
+    nxt[pos] = e.head;
+    e.head = pos;
+  }
+
+  template <class Eq>
+  int scan(const Slot &e, Eq &eq) const
+  {
+    if (e.head < 0)
+      return eq(~e.head) ? ~e.head : -1;
+    for (int p = e.head; p != -1; p = nxt[p])
+      if (eq(p))
+        return p;
+    return -1;
+  }
+};
+
+// out[i] = rh.get(i, i+L)  (0 <= i < cnt)
+inline void hash_windows(const RollingHash &rh, int L, int cnt, vector<unsigned long long> &out,
+                         int threads)
+{
+  out.resize(max(cnt, 0));
+  auto work = [&](int lo, int hi)
+  {
+    for (int i = lo; i < hi; ++i)
+      out[i] = rh.get(i, i + L);
+  };
+  int T = threads > 0 ? threads : max(1, (int)thread::hardware_concurrency());
+  T = min(T, cnt >> 16); // 小さい入力はスレッドを立てない
+  if (T <= 1)
+  {
+    work(0, cnt);
+    return;
+  }
+  vector<thread> pool;
+  for (int t = 1; t < T; ++t)
+    pool.emplace_back(work, (long long)cnt * t / T, (long long)cnt * (t + 1) / T);
+  work(0, cnt / T);
+  for (auto &th : pool)
+    th.join();
+}
+
 /************************************************************
 ◆ 典型用法 (RollingHash で LCS)
     auto [len, ia, ib] = longest_common_substr(A, B);
@@ -154,8 +392,124 @@ bool is_pal(const RollingHash &fwd, const RollingHash &rev, int l, int r, int N)
     // A.substr(ia,len) が最長の一例
 ************************************************************/
 // 返り値: pair<長さ, (A側の開始位置, B側の開始位置)>
-// 解が複数ある場合は最初に見つかったもの
-tuple<int, int, int> longest_common_substr(const string &A, const string &B)
+// 解が複数ある場合は B 側の開始位置が最小のもの (A 側はその中で最小)
+//   長さ L の判定 : A の窓を表に入れ (同じハッシュは最初の位置のみ)、B の窓を前から引く
+tuple<int, int, int> longest_common_substr(const string &A, const string &B, int threads = 0)
+{
+  int NA = (int)A.size(), NB = (int)B.size();
+  RollingHash ha(A), hb(B);
+
+  int lo = 0, hi = min(NA, NB), bestLen = 0;
+  int bestIa = -1, bestIb = -1;
+
+  FlatHashIndex table;
+  vector<unsigned long long> wa, wb;
+  auto existsLen = [&](int L) -> bool
+  {
+    const int ca = NA - L + 1, cb = NB - L + 1;
+    hash_windows(ha, L, ca, wa, threads);
+    hash_windows(hb, L, cb, wb, threads);
+    table.reset(ca);
+    for (int i = ca - 1; i >= 0; --i) // 逆順に足して、同じハッシュ値では小さい位置から辿る
+      table.add(wa[i], i);
+
+    for (int j = 0; j < cb; ++j)
+    {
+      // 衝突チェック (中身が一致する位置を探す)
+      int ia = table.find(wb[j], [&](int i)
+                          { return A.compare(i, L, B, j, L) == 0; });
+      if (ia != -1)
+      {
+        bestIa = ia;
+        bestIb = j;
+        return true;
+      }
+    }
+    return false;
+  };
+
+  while (lo <= hi)
+  {
+    int mid = (lo + hi) / 2;
+    if (existsLen(mid))
+    { // 長さ mid の共通部分文字列が存在 (失敗時は bestIa/bestIb を触らない)
+      bestLen = mid;
+      lo = mid + 1;
+    }
+    else
+      hi = mid - 1;
+  }
+  return {bestLen, bestIa, bestIb}; // bestIa = -1 なら空文字
+}
+
+/************************************************************
+◆ 典型用法 (最長重複部分列= 文字列 S 内で 2 回以上現れる最長の連続部分文字列)
+    auto [len,pos] = longest_repeated_substr_hash(S);
+    // S.substr(pos,len) が S 内で 2 回以上現れる最長部分文字列
+************************************************************/
+//======================================================================
+// ① RollingHash + 二分探索 + FlatHashIndex   O(N log N)
+//    表と窓ハッシュ配列は全ステップで使い回す (ステップ毎の確保なし)。
+//    返り値: {長さ, 開始位置}  (存在しなければ {0,-1})
+//======================================================================
+inline std::pair<int, int> longest_repeated_substr_hash(const std::string &S, int threads = 0)
+{
+  const int N = (int)S.size();
+  if (N <= 1)
+    return {0, -1};
+
+  RollingHash rh(S);
+  int bestLen = 0, bestPos = -1;
+
+  FlatHashIndex table;
+  vector<unsigned long long> w;
+  // 真偽判定: 長さ L の重複部分文字列があるか
+  auto existLen = [&](int L) -> bool
+  {
+    const int cnt = N - L + 1;
+    hash_windows(rh, L, cnt, w, threads);
+    table.reset(cnt);
+    for (int i = 0; i < cnt; ++i)
+    {
+      // 衝突確認 (中身が一致する既出の位置を探す。一致が無いときだけ i を足すので同じ中身は 1 つ)
+      int j = table.find_or_add(w[i], i, [&](int k)
+                                { return S.compare(k, L, S, i, L) == 0; });
+      if (j != -1)
+      {
+        bestPos = j; // 代表位置 (最初の出現) を保存
+        return true;
+      }
+    }
+    return false;
+  };
+
+  // 長さを二分探索
+  for (int lo = 1, hi = N - 1; lo <= hi;)
+  {
+    int mid = (lo + hi) / 2;
+    if (existLen(mid))
+    { // mid が作れる
+      bestLen = mid;
+      lo = mid + 1;
+    }
+    else
+      hi = mid - 1;
+  }
+  return {bestLen, bestPos};
+}
+
+/*--------------------- benchmark / demo ---------------------*/
+// 入力が無ければ RollingHash (2^61-1) / RollingHash64 / DoubleHash を比較
+//   DoubleHash も計測するには -DDOUBLE_HASH でビルド
+// 続けて最長重複 / 最長共通部分文字列を旧実装・SA 版と比較
+//   既定は N = 2*10^5 の小さな確認のみ。`./a.out bench [N]` で N = 10^7 (既定) の計測
+//   (旧実装は N = 10^7 で数分かかる)
+#ifndef ROLLINGHASH_NO_DEMO
+#define SUFFIXARRAY_NO_DEMO
+#include "SuffixArray.cpp"
+
+// 旧実装 (ステップ毎に unordered_map を作る版) : 比較用
+tuple<int, int, int> longest_common_substr_legacy(const string &A, const string &B)
 {
   int NA = (int)A.size(), NB = (int)B.size();
   RollingHash ha(A), hb(B);
@@ -209,17 +563,7 @@ tuple<int, int, int> longest_common_substr(const string &A, const string &B)
   return {bestLen, bestIa, bestIb}; // bestIa = -1 なら空文字
 }
 
-/************************************************************
-◆ 典型用法 (最長重複部分列= 文字列 S 内で 2 回以上現れる最長の連続部分文字列)
-    auto [len,pos] = longest_repeated_substr_hash(S);
-    // S.substr(pos,len) が S 内で 2 回以上現れる最長部分文字列
-************************************************************/
-//======================================================================
-// ① RollingHash + 二分探索 + ハッシュ集合   O(N log N)
-//    文字列長 2e5 程度までなら十分高速。衝突が気になる場合は DoubleHash に置換。
-//    返り値: {長さ, 開始位置}  (存在しなければ {0,-1})
-//======================================================================
-inline std::pair<int, int> longest_repeated_substr_hash(const std::string &S)
+inline std::pair<int, int> longest_repeated_substr_hash_legacy(const std::string &S)
 {
   using ull = unsigned long long;
   const int N = (int)S.size();
@@ -270,12 +614,104 @@ inline std::pair<int, int> longest_repeated_substr_hash(const std::string &S)
   return {bestLen, bestPos};
 }
 
-int main()
+// longest_repeated_substr_hash / longest_common_substr を旧実装・SA 版と比較
+void bench_longest_substr(int N)
+{
+  using clk = chrono::steady_clock;
+  mt19937 rng(2);
+  string S(N, 'a'), A(N / 2, 'a'), B(N / 2, 'a');
+  for (auto &c : S)
+    c = char('a' + rng() % 4);
+  for (auto &c : A)
+    c = char('a' + rng() % 4);
+  for (auto &c : B)
+    c = char('a' + rng() % 4);
+  auto ms = [](auto d)
+  { return chrono::duration<double, milli>(d).count(); };
+  auto t0 = clk::now();
+  auto r1 = longest_repeated_substr_hash(S);
+  auto t1 = clk::now();
+  auto r2 = longest_repeated_substr_hash_legacy(S);
+  auto t2 = clk::now();
+  SuffixArray sa(S);
+  auto r3 = longest_repeated_substr_sa(sa);
+  auto t3 = clk::now();
+  cout << "N=" << N << " repeated  flat " << ms(t1 - t0) << " ms  legacy " << ms(t2 - t1)
+       << " ms  SA " << ms(t3 - t2) << " ms  len=" << r1.first
+       << (r1 == r2 && r1.first == r3.first ? "" : "  (MISMATCH)") << '\n';
+  auto t4 = clk::now();
+  auto c1 = longest_common_substr(A, B);
+  auto t5 = clk::now();
+  auto c2 = longest_common_substr_legacy(A, B);
+  auto t6 = clk::now();
+  cout << "N=" << N << " common    flat " << ms(t5 - t4) << " ms  legacy " << ms(t6 - t5)
+       << " ms  len=" << get<0>(c1) << (c1 == c2 ? "" : "  (MISMATCH)") << '\n';
+}
+
+void bench_rolling_hash(int N)
+{
+  using clk = chrono::steady_clock;
+  const int Q = N;
+  mt19937 rng(1);
+  string S(N, 'a');
+  for (auto &c : S)
+    c = char('a' + rng() % 26);
+  vector<array<int, 3>> qs(Q); // [i, i+len) と [j, j+len)
+  for (auto &[i, j, len] : qs)
+  {
+    len = rng() % 1000 + 1;
+    i = rng() % (N - len);
+    j = rng() % 2 ? i : rng() % (N - len);
+  }
+  auto run = [&](const char *name, auto &&make)
+  {
+    auto t0 = clk::now();
+    auto h = make(S);
+    auto t1 = clk::now();
+    int eq = 0;
+    for (auto [i, j, len] : qs)
+      eq += h.same(i, i + len, j, j + len);
+    auto t2 = clk::now();
+    cout << name << " build " << chrono::duration<double, milli>(t1 - t0).count() << " ms  same "
+         << chrono::duration<double, nano>(t2 - t1).count() / Q << " ns/q  (eq=" << eq << ")\n";
+  };
+  run("RollingHash   ", [](const string &s)
+      { return RollingHash(s); });
+  run("RollingHash64 ", [](const string &s)
+      { return RollingHash64(s); });
+#ifdef DOUBLE_HASH
+  run("DoubleHash    ", [](const string &s)
+      { return DoubleHash(s); });
+#endif
+
+  // Thue–Morse 列 t と反転 ~t : mod 2^64 では base (奇数) によらず同じハッシュになる
+  string tm(1 << 11, 'a'), inv(1 << 11, 'a');
+  for (int i = 0; i < (1 << 11); ++i)
+  {
+    tm[i] = char('a' + __builtin_parity(i));
+    inv[i] = char('b' - __builtin_parity(i));
+  }
+  string TM = tm + inv;
+  RollingHash64 h64(TM, (rng() << 1) | 1);
+  RollingHash h61(TM);
+  const int L = 1 << 11;
+  cout << "Thue-Morse t vs ~t (differ)  RollingHash64 same=" << h64.same(0, L, L, 2 * L)
+       << "  RollingHash same=" << h61.same(0, L, L, 2 * L) << '\n';
+}
+
+int main(int argc, char **argv)
 {
   ios::sync_with_stdio(false);
   cin.tie(nullptr);
   string S, P;
-  cin >> S >> P;
+  if (!(cin >> S >> P))
+  {
+    // 入力が無ければベンチマーク (引数 bench で本番サイズ)
+    const bool full = argc >= 2 && string(argv[1]) == "bench";
+    bench_rolling_hash(full ? 10000000 : 1000000);
+    bench_longest_substr(full ? (argc >= 3 ? atoi(argv[2]) : 10000000) : 200000);
+    return 0;
+  }
   RollingHash rh(S);
   RollingHash hp(P);
   auto target = hp.get(0, P.size());
@@ -295,3 +731,4 @@ int main()
     cout << "\n";
   }
 }
+#endif
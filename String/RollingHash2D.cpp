@@ -0,0 +1,264 @@
+/************************************************************
+  Rolling Hash 2D  –  2 次元多項式ハッシュで部分長方形を O(1) 照合
+  ----------------------------------------------------------
+  ◆ できること (H×W = 盤面, P×Q = パターン, T = スレッド数)
+    - 前計算 build(g)                      | O(HW / T)
+    - 部分長方形のハッシュ get(r1,c1,r2,c2) | O(1)   ※半開区間
+    - 2 長方形の一致判定 same(...)          | O(1)
+    - パターン全出現 grid_search(g, pat)    | O((HW + 一致数 * PQ) / T)
+
+  ◆ 実装方針
+    * RollingHash と同じ mod 2^61-1。列方向 (横) の base は RollingHash::base()、
+      行方向 (縦) の base は別に乱択した独立な値。
+    * 累積ハッシュは (H+1)*(W+1) の 1 本の配列。
+      横方向の累積 (行ごと独立) → 縦方向の累積 (列ごと独立) の 2 パスで、
+      それぞれ行帯 / 列帯に分けて並列に作る。
+    * grid_search は行帯ごとにスレッドへ割り振り、ハッシュ一致した位置だけ
+      全セルを比較して確定する (衝突しても誤検出しない)。
+    * 盤面は g[i][j] で読めれば何でもよい (vector<string>, vector<vector<int>> ...)。
+
+  ◆ 典型用法
+      RollingHash2D hs(S);                   // vector<string> S (H 行)
+      if (hs.same(r1, c1, r2, c2, r3, c3)) ...   // [r1,r2)×[c1,c2) と (r3,c3) 起点の同サイズ
+      auto hit = grid_search(S, Pat);        // 左上座標 {i, j} の一覧 (行優先順)
+************************************************************/
+
+#pragma once
+#include <bits/stdc++.h>
+#define ROLLINGHASH_NO_DEMO
+#include "RollingHash.cpp"
+using namespace std;
+
+struct RollingHash2D
+{
+  using ull = unsigned long long;
+  static constexpr ull MOD = RollingHash::MOD;
+
+  // 行方向の base (列方向の RollingHash::base() とは独立)
+  static ull base_row()
+  {
+    static const ull b = []
+    {
+      mt19937_64 rng(random_device{}() * 0x9E3779B97F4A7C15ull + 1);
+      ull x;
+      do
+        x = rng() % (MOD - (1 << 20)) + (1 << 20);
+      while (x == RollingHash::base());
+      return x;
+    }();
+    return b;
+  }
+
+  int H = 0, W = 0;
+  vector<ull> pref; // pref[i*(W+1)+j] : [0,i)×[0,j) のハッシュ
+  vector<ull> pw_row;
+  shared_ptr<const vector<ull>> pow_table;
+  const ull *pw_col = nullptr;
+
+  RollingHash2D() = default;
+  template <class Grid>
+  explicit RollingHash2D(const Grid &g, int threads = 0) { build(g, threads); }
+
+  template <class Grid>
+  void build(const Grid &g, int threads = 0)
+  {
+    H = (int)g.size();
+    W = H ? (int)g[0].size() : 0;
+    const size_t S = W + 1;
+    pow_table = RollingHash::powers(W + 1);
+    pw_col = pow_table->data();
+    pw_row.resize(H + 1);
+    pw_row[0] = 1;
+    for (int i = 0; i < H; ++i)
+      pw_row[i + 1] = RollingHash::mul(pw_row[i], base_row());
+
+    pref.assign((size_t)(H + 1) * S, 0);
+    const ull bc = RollingHash::base(), br = base_row();
+    // 横方向 : 行 i の累積を pref[(i+1)*S + j] に置く
+    run_bands(H, threads, [&](int lo, int hi)
+              {
+      for (int i = lo; i < hi; ++i)
+      {
+        ull *row = &pref[(i + 1) * S];
+        for (int j = 0; j < W; ++j)
+          row[j + 1] = add(RollingHash::mul(row[j], bc), RollingHash::code(g[i][j]));
+      } });
+    // 縦方向 : 列ごとに上から畳み込む
+    run_bands(W + 1, threads, [&](int lo, int hi)
+              {
+      for (int i = 0; i < H; ++i)
+      {
+        const ull *up = &pref[i * S];
+        ull *cur = &pref[(i + 1) * S];
+        for (int j = lo; j < hi; ++j)
+          cur[j] = add(RollingHash::mul(up[j], br), cur[j]);
+      } });
+  }
+
+  // [r1,r2)×[c1,c2) のハッシュ
+  ull get(int r1, int c1, int r2, int c2) const
+  {
+    const size_t S = W + 1;
+    const ull a = pref[r2 * S + c2], b = pref[r1 * S + c2], c = pref[r2 * S + c1], d = pref[r1 * S + c1];
+    const ull ph = pw_row[r2 - r1], pw = pw_col[c2 - c1];
+    ull x = sub(a, RollingHash::mul(b, ph));
+    ull y = sub(c, RollingHash::mul(d, ph));
+    return sub(x, RollingHash::mul(y, pw));
+  }
+
+  // [r1,r2)×[c1,c2) と左上 (r3,c3) の同サイズ長方形が一致するか
+  bool same(int r1, int c1, int r2, int c2, int r3, int c3) const
+  {
+    return get(r1, c1, r2, c2) == get(r3, c3, r3 + (r2 - r1), c3 + (c2 - c1));
+  }
+
+  // [0,n) を帯に分けて f(lo, hi) を並列に呼ぶ (1 帯あたり grain 以上)
+  template <class F>
+  static void run_bands(int n, int threads, F f, int grain = 64)
+  {
+    int T = threads > 0 ? threads : max(1, (int)thread::hardware_concurrency());
+    T = max(1, min(T, n / grain)); // 小さい盤面はスレッドを立てない
+    if (T == 1)
+    {
+      f(0, n);
+      return;
+    }
+    vector<thread> pool;
+    for (int t = 1; t < T; ++t)
+      pool.emplace_back(f, (int)((long long)n * t / T), (int)((long long)n * (t + 1) / T));
+    f(0, n / T);
+    for (auto &th : pool)
+      th.join();
+  }
+
+private:
+  static ull add(ull a, ull b)
+  {
+    a += b;
+    return a >= MOD ? a - MOD : a;
+  }
+  static ull sub(ull a, ull b) { return a >= b ? a - b : a + MOD - b; }
+};
+
+/*------------------------------------------------------------
+  grid_search(g, pat, threads = 0)
+    返り値 : pat が g[i..i+P)[j..j+Q) に一致する左上 {i, j} (行優先順)
+------------------------------------------------------------*/
+template <class Grid>
+vector<pair<int, int>> grid_search(const Grid &g, const Grid &pat, int threads = 0)
+{
+  const int H = (int)g.size(), W = H ? (int)g[0].size() : 0;
+  const int P = (int)pat.size(), Q = P ? (int)pat[0].size() : 0;
+  if (P == 0 || Q == 0 || P > H || Q > W)
+    return {};
+  RollingHash2D hg(g, threads), hp(pat, 1);
+  const auto target = hp.get(0, 0, P, Q);
+  auto sub_mod = [](unsigned long long a, unsigned long long b)
+  { return a >= b ? a - b : a + RollingHash::MOD - b; };
+
+  // 行帯 b = [rows*b/B, rows*(b+1)/B) ごとに結果を分けて持ち、最後に連結
+  const int rows = H - P + 1;
+  int T = threads > 0 ? threads : max(1, (int)thread::hardware_concurrency());
+  const int B = max(1, min(T, rows));
+  vector<vector<pair<int, int>>> part(B);
+  const size_t S = W + 1;
+  const auto pw_p = hg.pw_row[P], pw_q = hg.pw_col[Q];
+  RollingHash2D::run_bands(B, T, [&](int b0, int b1)
+                           {
+    vector<unsigned long long> x(S); // x[j] : 行 [i,i+P) × 列 [0,j) のハッシュ
+    for (int b = b0; b < b1; ++b)
+      for (int i = (int)((long long)rows * b / B); i < (long long)rows * (b + 1) / B; ++i)
+      {
+        const auto *lo = &hg.pref[i * S], *hi = &hg.pref[(i + P) * S];
+        for (size_t j = 0; j < S; ++j)
+          x[j] = sub_mod(hi[j], RollingHash::mul(lo[j], pw_p));
+        for (int j = 0; j + Q <= W; ++j)
+        {
+          if (sub_mod(x[j + Q], RollingHash::mul(x[j], pw_q)) != target)
+            continue;
+          bool ok = true; // 衝突チェック
+          for (int k = 0; k < P && ok; ++k)
+            ok = equal(pat[k].begin(), pat[k].end(), g[i + k].begin() + j);
+          if (ok)
+            part[b].emplace_back(i, j);
+        }
+      } }, 1);
+  vector<pair<int, int>> res;
+  for (auto &v : part)
+    res.insert(res.end(), v.begin(), v.end());
+  return res;
+}
+
+/*--------------------- benchmark / demo ---------------------*/
+// 1D RollingHash を行ごとに使う従来方式と grid_search を比較 (2000×2000, 2 値)
+#ifndef ROLLINGHASH2D_NO_DEMO
+vector<pair<int, int>> grid_search_rows(const vector<string> &g, const vector<string> &pat)
+{
+  const int H = g.size(), W = g[0].size(), P = pat.size(), Q = pat[0].size();
+  vector<RollingHash> rh(H);
+  for (int i = 0; i < H; ++i)
+    rh[i].build(g[i]);
+  vector<unsigned long long> ph(P);
+  for (int k = 0; k < P; ++k)
+    ph[k] = RollingHash(pat[k]).get(0, Q);
+  vector<pair<int, int>> res;
+  for (int i = 0; i + P <= H; ++i)
+    for (int j = 0; j + Q <= W; ++j)
+    {
+      int k = 0;
+      while (k < P && rh[i + k].get(j, j + Q) == ph[k] && g[i + k].compare(j, Q, pat[k]) == 0)
+        ++k;
+      if (k == P)
+        res.emplace_back(i, j);
+    }
+  return res;
+}
+
+int main()
+{
+  ios::sync_with_stdio(false);
+  cin.tie(nullptr);
+
+  using clk = chrono::steady_clock;
+  auto ms = [](auto d)
+  { return chrono::duration<double, milli>(d).count(); };
+  auto run = [&](const char *name, const vector<string> &g, const vector<string> &pat)
+  {
+    auto t0 = clk::now();
+    auto a = grid_search_rows(g, pat);
+    auto t1 = clk::now();
+    auto b = grid_search(g, pat, 1);
+    auto t2 = clk::now();
+    auto c = grid_search(g, pat);
+    auto t3 = clk::now();
+    cout << name << "  rows of 1D hash " << ms(t1 - t0) << " ms  grid_search 1T " << ms(t2 - t1)
+         << " ms  all " << ms(t3 - t2) << " ms  hits=" << c.size() << (a == b && b == c ? "" : "  (MISMATCH)")
+         << '\n';
+  };
+
+  const int H = 2000, W = 2000, P = 8, Q = 8;
+  mt19937 rng(1);
+  // 1. 乱数盤面に既知のパターンを埋め込む
+  vector<string> g(H, string(W, '.'));
+  for (auto &row : g)
+    for (auto &c : row)
+      c = rng() % 2 ? '#' : '.';
+  vector<string> pat(P);
+  for (int k = 0; k < P; ++k)
+    pat[k] = g[777 + k].substr(555, Q);
+  for (int t = 0; t < 300; ++t)
+  {
+    int i = rng() % (H - P), j = rng() % (W - Q);
+    for (int k = 0; k < P; ++k)
+      g[i + k].replace(j, Q, pat[k]);
+  }
+  run("random ", g, pat);
+
+  // 2. ほぼ一様な盤面 : 行単位の照合はどの位置でも P-1 行まで一致してしまう
+  vector<string> u(H, string(W, '.')), up(32, string(32, '.'));
+  up[31][31] = '#';
+  for (int t = 0; t < 100; ++t)
+    u[rng() % H][rng() % W] = '#';
+  run("uniform", u, up);
+}
+#endif
@@ -0,0 +1,169 @@
+/************************************************************
+  SIMD Search  –  先頭/末尾 byte の一括比較による厳密部分文字列検索
+  ----------------------------------------------------------
+  ◆ できること (N = |T|, M = |P|)          | 時間計算量
+    - 出現位置列挙 simd_search(T, P)      | O(N) 期待 (最悪 O(NM))
+    - コールバック版 simd_find_all(T,P,f) | 同上 (結果配列を作らない)
+
+  ◆ 実装方針
+    * 32 (AVX2) / 16 (SSE2) byte ずつ T[i] == P[0] と T[i+M-1] == P[M-1]
+      を同時に比較し、両方立った位置だけ memcmp で本照合する。
+    * 使う命令セットは実行時に __builtin_cpu_supports で選ぶ。
+      x86 以外では memchr + memcmp のスカラ版になる。
+    * 任意の byte 列を扱える (z_search の '$' 連結のような制約・コピー無し)。
+    * 返り値は kmp_search / z_search と同じ (空パターンは {0})。
+
+  ◆ 典型用法
+      auto hit = simd_search(T, P);               // kmp_search と置換可
+      simd_find_all(T, P, [&](size_t pos){ ... }); // 巨大テキスト向け
+************************************************************/
+
+#pragma once
+#include <bits/stdc++.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SIMD_SEARCH_X86
+#endif
+using namespace std;
+
+namespace simd_search_impl
+{
+  // 候補位置 i から 1..M-2 byte 目を照合 (先頭・末尾は SIMD で確認済み)
+  inline bool verify(const char *t, const char *p, size_t m)
+  {
+    return m <= 2 || memcmp(t + 1, p + 1, m - 2) == 0;
+  }
+
+  template <class F>
+  void scalar(const char *t, size_t n, const char *p, size_t m, size_t from, F &f)
+  {
+    const char *end = t + n - m + 1;
+    for (const char *s = t + from; s < end;)
+    {
+      s = (const char *)memchr(s, p[0], end - s);
+      if (!s)
+        return;
+      if (s[m - 1] == p[m - 1] && verify(s, p, m))
+        f((size_t)(s - t));
+      ++s;
+    }
+  }
+
+#ifdef SIMD_SEARCH_X86
+  template <class F>
+  __attribute__((target("avx2"))) void avx2(const char *t, size_t n, const char *p, size_t m, F &f)
+  {
+    const __m256i first = _mm256_set1_epi8(p[0]), last = _mm256_set1_epi8(p[m - 1]);
+    size_t i = 0;
+    for (; i + 32 + m - 1 <= n; i += 32)
+    {
+      __m256i bf = _mm256_loadu_si256((const __m256i *)(t + i));
+      __m256i bl = _mm256_loadu_si256((const __m256i *)(t + i + m - 1));
+      unsigned mask = (unsigned)_mm256_movemask_epi8(
+          _mm256_and_si256(_mm256_cmpeq_epi8(first, bf), _mm256_cmpeq_epi8(last, bl)));
+      for (; mask; mask &= mask - 1)
+      {
+        size_t k = i + __builtin_ctz(mask);
+        if (verify(t + k, p, m))
+          f(k);
+      }
+    }
+    scalar(t, n, p, m, i, f);
+  }
+
+  template <class F>
+  void sse2(const char *t, size_t n, const char *p, size_t m, F &f)
+  {
+    const __m128i first = _mm_set1_epi8(p[0]), last = _mm_set1_epi8(p[m - 1]);
+    size_t i = 0;
+    for (; i + 16 + m - 1 <= n; i += 16)
+    {
+      __m128i bf = _mm_loadu_si128((const __m128i *)(t + i));
+      __m128i bl = _mm_loadu_si128((const __m128i *)(t + i + m - 1));
+      unsigned mask = (unsigned)_mm_movemask_epi8(
+          _mm_and_si128(_mm_cmpeq_epi8(first, bf), _mm_cmpeq_epi8(last, bl)));
+      for (; mask; mask &= mask - 1)
+      {
+        size_t k = i + __builtin_ctz(mask);
+        if (verify(t + k, p, m))
+          f(k);
+      }
+    }
+    scalar(t, n, p, m, i, f);
+  }
+
+  inline bool has_avx2()
+  {
+    static const bool ok = __builtin_cpu_supports("avx2");
+    return ok;
+  }
+#endif
+} // namespace simd_search_impl
+
+// f(pos) : pat が text[pos, pos+M) に現れた (pos 昇順)
+template <class F>
+void simd_find_all(string_view text, string_view pat, F f)
+{
+  const size_t n = text.size(), m = pat.size();
+  if (m == 0)
+  {
+    f(size_t(0));
+    return;
+  }
+  if (m > n)
+    return;
+#ifdef SIMD_SEARCH_X86
+  if (simd_search_impl::has_avx2())
+    simd_search_impl::avx2(text.data(), n, pat.data(), m, f);
+  else
+    simd_search_impl::sse2(text.data(), n, pat.data(), m, f);
+#else
+  simd_search_impl::scalar(text.data(), n, pat.data(), m, 0, f);
+#endif
+}
+
+// 返り値 : pat が現れる開始位置（0-indexed）の一覧  ※kmp_search と同じ
+vector<int> simd_search(const string &text, const string &pat)
+{
+  vector<int> res;
+  simd_find_all(text, pat, [&](size_t pos)
+                { res.push_back((int)pos); });
+  return res;
+}
+
+/*--------------------- benchmark / demo ---------------------*/
+// kmp_search / z_search / simd_search の処理速度 [MB/s] を比較
+#ifndef SIMDSEARCH_NO_DEMO
+#define KMP_NO_DEMO
+#include "KMP.cpp"
+#include "ZAlgorithm.cpp"
+int main()
+{
+  ios::sync_with_stdio(false);
+  cin.tie(nullptr);
+
+  const int N = 1 << 26;
+  mt19937 rng(1);
+  string T(N, 'a');
+  for (auto &c : T)
+    c = char(rng() % 256); // '$' や '\0' も含む任意 byte
+  string P = T.substr(N / 2, 16);
+
+  using clk = chrono::steady_clock;
+  auto bench = [&](const char *name, auto fn)
+  {
+    auto t0 = clk::now();
+    auto hit = fn(T, P);
+    double sec = chrono::duration<double>(clk::now() - t0).count();
+    cout << name << " hits=" << hit.size() << "  " << N / sec / 1e6 << " MB/s\n";
+    return hit;
+  };
+  auto a = bench("kmp_search ", kmp_search);
+  auto b = bench("z_search   ", z_search);
+  auto c = bench("simd_search", simd_search);
+#ifdef SIMD_SEARCH_X86
+  cout << "isa: " << (simd_search_impl::has_avx2() ? "AVX2" : "SSE2") << '\n';
+#endif
+  cout << "same result: " << boolalpha << (a == b && b == c) << '\n';
+}
+#endif
@@ -0,0 +1,471 @@
+/************************************************************
+  Stream Hash  –  チャンク単位で流し込むローリングハッシュ / CDC / winnowing
+  ----------------------------------------------------------
+  ◆ できること (w = 窓長)                            | 時間計算量
+    - RollingWindowHash : 長さ w の全窓のハッシュ     | O(1) / byte
+        値は RollingHash::get(pos, pos+w) と一致 (mod 2^61-1, 同じ base)
+    - GearChunker       : 内容依存チャンク境界 (Gear / FastCDC 風)
+                          min / 平均 / max サイズ指定       | O(1) / byte
+    - Winnower          : 連続 w 個のハッシュの最小値を指紋として選ぶ
+                          (同値は右端, 単調 deque)          | 償却 O(1) / 個
+    - BlockWinnower     : 同じ結果をブロック分割の接頭辞 / 接尾辞最小で
+                          (データ依存の分岐なし)            | O(1) / 個
+    - parallel_files    : 複数ファイルを mmap してファイル単位で並列処理
+
+  ◆ 実装方針
+    * どれも feed(chunk, f) で任意の長さに区切って流し込める。
+      区切り方によらず同じ位置・同じ値が得られる (位置は通し番号)。
+    * RollingWindowHash は 1 byte ごとに 128 bit 乗算 1 回の依存鎖になるので、
+      大きなチャンクは 8 レーンに分けて鎖を並行に回す
+      (各レーンの先頭窓は直前 w byte から作り直す)。
+      鎖の中では剰余を [0, 2^62) までしか畳まず、最後の比較・減算は
+      出力時 (鎖の外) に行う。
+    * 出ていく byte の寄与 code(c) * b^w は表引き。
+    * GearChunker の gear 表は固定 seed なので、実行・マシンが違っても境界は同じ。
+
+  ◆ 典型用法
+      RollingWindowHash rw(48);
+      Winnower win(64);
+      vector<pair<uint64_t, unsigned long long>> fp;   // {位置, ハッシュ}
+      rw.feed(chunk, [&](uint64_t pos, auto h){
+          win.push(h, pos, [&](uint64_t p, auto v){ fp.emplace_back(p, v); });
+      });
+
+      GearChunker cdc(8192);                 // 平均 8 KiB
+      cdc.feed(chunk, [&](uint64_t end){ ... });   // [前の境界, end) が 1 チャンク
+      cdc.finish([&](uint64_t end){ ... });        // 末尾の残り
+************************************************************/
+
+#pragma once
+#include <bits/stdc++.h>
+#define ROLLINGHASH_NO_DEMO
+#include "RollingHash.cpp"
+#include "MappedFile.cpp"
+using namespace std;
+
+/*------------------------------------------------------------
+  RollingWindowHash(w)
+    feed(s, f) : f(pos, hash) を窓 [pos, pos+w) が完成するごとに pos 昇順で呼ぶ
+------------------------------------------------------------*/
+struct RollingWindowHash
+{
+  using ull = unsigned long long;
+  static constexpr ull MOD = RollingHash::MOD;
+  static constexpr int LANES = 8;
+
+  int w;
+  ull b, h = 0;            // h は未正規化 (< 2^62, 値は mod MOD で正しい)
+  array<ull, 256> in, out; // code(c), -code(c) * b^w
+  string tail;             // 直前までの末尾 min(w, consumed) byte
+  uint64_t consumed = 0;
+  int lane_len;
+  vector<ull> buf;
+
+  explicit RollingWindowHash(int w_) : w(w_), b(RollingHash::base())
+  {
+    const ull bw = (*RollingHash::powers(w + 1))[w];
+    for (int c = 0; c < 256; ++c)
+    {
+      in[c] = RollingHash::code((unsigned char)c);
+      out[c] = MOD - RollingHash::mul(in[c], bw);
+    }
+    lane_len = max(4096, 4 * w);
+    buf.resize((size_t)LANES * lane_len);
+  }
+
+  void reset()
+  {
+    h = 0;
+    tail.clear();
+    consumed = 0;
+  }
+
+  template <class F>
+  void feed(string_view s, F f)
+  {
+    const size_t n = s.size(), W = w;
+    const auto *p = (const unsigned char *)s.data();
+    size_t i = 0;
+    // 出ていく byte が前のチャンク側にある (または存在しない) 部分
+    for (; i < n && i < W; ++i)
+    {
+      const uint64_t a = consumed + i;
+      h = step(h, b, in[p[i]] + (a >= W ? out[(unsigned char)tail[tail.size() - W + i]] : 0));
+      if (a + 1 >= W)
+        f(a + 1 - W, canon(h));
+    }
+    // LANES 本並行 : 鎖 1 本の遅延 (乗算 + 畳み込み) を LANES byte で分け合う
+    const size_t block = (size_t)LANES * lane_len;
+    for (; i + block <= n; i += block)
+    {
+      ull hl[LANES];
+      hl[0] = h;
+      for (int k = 1; k < LANES; ++k)
+        hl[k] = 0;
+      for (size_t t = 0; t < W; ++t) // レーン 1.. の直前の窓を作る
+        for (int k = 1; k < LANES; ++k)
+          hl[k] = step(hl[k], b, in[p[i + k * lane_len - W + t]]);
+      const unsigned char *q = p + i;
+      for (int t = 0; t < lane_len; ++t)
+        for (int k = 0; k < LANES; ++k)
+        {
+          const size_t o = (size_t)k * lane_len + t;
+          hl[k] = step(hl[k], b, in[q[o]] + out[q[o - W]]);
+          buf[o] = canon(hl[k]);
+        }
+      h = hl[LANES - 1];
+      const uint64_t base_pos = consumed + i + 1 - W;
+      for (size_t j = 0; j < block; ++j)
+        f(base_pos + j, buf[j]);
+    }
+    for (; i < n; ++i)
+    {
+      h = step(h, b, in[p[i]] + out[p[i - W]]);
+      f(consumed + i + 1 - W, canon(h));
+    }
+
+    if (n >= W)
+      tail.assign(s.substr(n - W));
+    else
+    {
+      tail.append(s);
+      if (tail.size() > W)
+        tail.erase(0, tail.size() - W);
+    }
+    consumed += n;
+  }
+
+private:
+  // h < 2^62, a < 2^62 → (h * b + a) mod MOD の代表 (< 2^62)。
+  //   最後の x >= MOD の比較は鎖から外し、出力時の canon だけで行う
+  static ull step(ull h, ull b, ull a)
+  {
+    const __uint128_t t = (__uint128_t)h * b;
+    const ull x = ((ull)t & MOD) + (ull)(t >> 61) + a;
+    return (x & MOD) + (x >> 61);
+  }
+  // < 2^62 の代表 → [0, MOD)
+  static ull canon(ull x)
+  {
+    x = (x & MOD) + (x >> 61);
+    return x >= MOD ? x - MOD : x;
+  }
+};
+
+/*------------------------------------------------------------
+  GearChunker(avg, min = avg/4, max = avg*8)
+    g = (g << 1) + gear[byte] の上位ビットが 0 になった所を境界にする。
+    長さ < avg では厳しいマスク (log2(avg)+2 bit)、以降は緩いマスク
+    (log2(avg)-2 bit) を使い、チャンク長を平均付近に寄せる (FastCDC)。
+    先頭 min byte はハッシュも取らずに読み飛ばす。
+------------------------------------------------------------*/
+struct GearChunker
+{
+  array<uint64_t, 256> gear;
+  size_t min_size, avg_size, max_size;
+  uint64_t mask_s, mask_l;
+  uint64_t g = 0, consumed = 0;
+  size_t len = 0; // 現在のチャンクの長さ
+
+  explicit GearChunker(size_t avg = 8192, size_t mn = 0, size_t mx = 0)
+      : min_size(mn ? mn : avg / 4), avg_size(avg), max_size(mx ? mx : avg * 8)
+  {
+    mt19937_64 rng(0x6765617243444321ull);
+    for (auto &x : gear)
+      x = rng();
+    const int bits = __lg(max<size_t>(avg, 16));
+    mask_s = ~0ull << (64 - (bits + 2));
+    mask_l = ~0ull << (64 - (bits - 2));
+  }
+
+  void reset()
+  {
+    g = consumed = 0;
+    len = 0;
+  }
+
+  // f(end) : チャンクが通し位置 end (exclusive) で終わった
+  template <class F>
+  void feed(string_view s, F f)
+  {
+    const auto *p = (const unsigned char *)s.data();
+    const size_t n = s.size();
+    size_t i = 0;
+    while (i < n)
+    {
+      if (len < min_size)
+      { // 読み飛ばし
+        size_t k = min(n - i, min_size - len);
+        i += k;
+        len += k;
+        continue;
+      }
+      // avg までは厳しいマスク、max までは緩いマスク
+      const bool small = len < avg_size;
+      const uint64_t mask = small ? mask_s : mask_l;
+      const size_t lim = min(n, i + ((small ? avg_size : max_size) - len));
+      uint64_t x = g;
+      size_t j = i;
+      bool found = false;
+      for (; j < lim; ++j)
+        if (!((x = (x << 1) + gear[p[j]]) & mask))
+        {
+          found = true;
+          ++j; // 境界 byte までを含めて切る
+          break;
+        }
+      len += j - i;
+      i = j;
+      g = x;
+      if (found || len == max_size)
+      {
+        f(consumed + i);
+        len = 0;
+        g = 0;
+      }
+    }
+    consumed += n;
+  }
+
+  // 末尾の残りを 1 チャンクとして閉じる
+  template <class F>
+  void finish(F f)
+  {
+    if (len)
+      f(consumed);
+    len = 0;
+    g = 0;
+  }
+};
+
+/*------------------------------------------------------------
+  Winnower(w)
+    push(hash, pos, f) : 直近 w 個のハッシュの最小値 (同値は右端) が
+    変わったら f(pos, hash) で報告する。deque は容量 2^k の環状配列。
+------------------------------------------------------------*/
+struct Winnower
+{
+  using ull = unsigned long long;
+  struct Item
+  {
+    ull h;
+    uint64_t pos, idx;
+  };
+  int w;
+  vector<Item> dq;
+  size_t mask, head = 0, tail = 0; // [head, tail) が deque
+  uint64_t cnt = 0, last = UINT64_MAX;
+
+  explicit Winnower(int w_) : w(w_)
+  {
+    size_t cap = 1;
+    while (cap < (size_t)w + 1)
+      cap <<= 1;
+    dq.resize(cap);
+    mask = cap - 1;
+  }
+
+  void reset()
+  {
+    head = tail = 0;
+    cnt = 0;
+    last = UINT64_MAX;
+  }
+
+  template <class F>
+  void push(ull h, uint64_t pos, F f)
+  {
+    while (tail != head && dq[(tail - 1) & mask].h >= h)
+      --tail;
+    dq[tail++ & mask] = Item{h, pos, cnt};
+    if (dq[head & mask].idx + w <= cnt)
+      ++head;
+    if (++cnt >= (uint64_t)w)
+    {
+      const Item &m = dq[head & mask];
+      if (m.idx != last)
+      {
+        last = m.idx;
+        f(m.pos, m.h);
+      }
+    }
+  }
+};
+
+/*------------------------------------------------------------
+  BlockWinnower(w)
+    Winnower と同じ push / 同じ報告列。deque の代わりに w 個ずつの
+    ブロックで区切り (van Herk / Gil-Werman)、
+      窓の最小 = min(前ブロックの接尾辞最小, 今のブロックの接頭辞最小)
+    で求める。比較は 1 個あたり 2 回 + ブロック完成時の接尾辞計算で、
+    データに依存する while が無い (分岐予測が外れにくい)。
+    キーは (hash << 64) | ~idx なので同値は右端が選ばれる。
+------------------------------------------------------------*/
+struct BlockWinnower
+{
+  using ull = unsigned long long;
+  using Key = __uint128_t;
+  int w, j = 0;            // j : 今のブロック内の位置
+  vector<Key> cur, suf;    // 今のブロック, 前ブロックの接尾辞最小 (suf[w] = 番兵)
+  vector<uint64_t> pos;    // idx → 位置 (容量 2^k の環状配列)
+  size_t mask;
+  Key pre = 0;
+  uint64_t cnt = 0, last = UINT64_MAX;
+
+  explicit BlockWinnower(int w_) : w(w_), cur(w_), suf(w_ + 1, ~Key(0))
+  {
+    size_t cap = 1;
+    while (cap < (size_t)w)
+      cap <<= 1;
+    pos.resize(cap);
+    mask = cap - 1;
+  }
+
+  void reset()
+  {
+    fill(suf.begin(), suf.end(), ~Key(0));
+    j = 0;
+    cnt = 0;
+    last = UINT64_MAX;
+  }
+
+  template <class F>
+  void push(ull h, uint64_t p, F f)
+  {
+    const Key key = (Key)h << 64 | ~cnt;
+    cur[j] = key;
+    pre = (j == 0 || key < pre) ? key : pre;
+    pos[cnt & mask] = p;
+    if (cnt + 1 >= (uint64_t)w)
+    {
+      const Key m = suf[j + 1] < pre ? suf[j + 1] : pre;
+      const uint64_t idx = ~(uint64_t)m;
+      if (idx != last)
+      {
+        last = idx;
+        f(pos[idx & mask], (ull)(m >> 64));
+      }
+    }
+    ++cnt;
+    if (++j == w)
+    {
+      Key x = ~Key(0);
+      for (int k = w - 1; k >= 0; --k)
+        suf[k] = x = cur[k] < x ? cur[k] : x;
+      j = 0;
+    }
+  }
+};
+
+/*------------------------------------------------------------
+  parallel_files(paths, work, threads = 0)
+    各ファイルを mmap し、work(file_index, string_view data) を
+    ファイル単位でスレッドに割り振って呼ぶ (開けなかったファイルは空の view)。
+    返り値 : 各ファイルを開けたか
+------------------------------------------------------------*/
+template <class Work>
+vector<char> parallel_files(const vector<string> &paths, Work work, int threads = 0)
+{
+  const int K = (int)paths.size();
+  int T = threads > 0 ? threads : max(1, (int)thread::hardware_concurrency());
+  T = max(1, min(T, K));
+  vector<char> ok(K);
+  atomic<int> next{0};
+  auto worker = [&]()
+  {
+    for (int k; (k = next.fetch_add(1)) < K;)
+    {
+      MappedFile f;
+      ok[k] = f.open(paths[k]);
+      work(k, f.view());
+    }
+  };
+  vector<thread> pool;
+  for (int t = 1; t < T; ++t)
+    pool.emplace_back(worker);
+  worker();
+  for (auto &th : pool)
+    th.join();
+  return ok;
+}
+
+/*--------------------- benchmark / demo ---------------------*/
+// ./a.out [file ...]
+//   引数なし : 256 MiB の乱数 byte 列を 1 MiB ずつ流し込み、各段の GB/s を表示
+//   引数あり : 各ファイルを parallel_files で処理し、チャンク数と指紋数を表示
+#ifndef STREAMHASH_NO_DEMO
+int main(int argc, char **argv)
+{
+  ios::sync_with_stdio(false);
+  cin.tie(nullptr);
+  const int K = 48, WIN = 64; // k-gram 長, winnowing の窓
+
+  if (argc >= 2)
+  {
+    vector<string> paths(argv + 1, argv + argc);
+    vector<size_t> chunks(paths.size()), prints(paths.size());
+    auto t0 = chrono::steady_clock::now();
+    auto ok = parallel_files(paths, [&](int k, string_view data)
+                             {
+      GearChunker cdc;
+      RollingWindowHash rw(K);
+      Winnower win(WIN);
+      cdc.feed(data, [&](uint64_t) { ++chunks[k]; });
+      cdc.finish([&](uint64_t) { ++chunks[k]; });
+      rw.feed(data, [&](uint64_t pos, auto h)
+              { win.push(h, pos, [&](uint64_t, auto) { ++prints[k]; }); }); });
+    double sec = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+    for (size_t k = 0; k < paths.size(); ++k)
+      cout << paths[k] << (ok[k] ? "" : " (open failed)") << "  chunks=" << chunks[k]
+           << "  fingerprints=" << prints[k] << '\n';
+    cout << sec << " s\n";
+    return 0;
+  }
+
+  const size_t N = size_t(1) << 28, C = size_t(1) << 20;
+  string T(N, 0);
+  mt19937_64 rng(1);
+  for (size_t i = 0; i < N; i += 8)
+  {
+    uint64_t x = rng();
+    memcpy(&T[i], &x, 8);
+  }
+  auto stream = [&](auto &&feed)
+  {
+    auto t0 = chrono::steady_clock::now();
+    for (size_t i = 0; i < N; i += C)
+      feed(string_view(T).substr(i, C));
+    return N / chrono::duration<double>(chrono::steady_clock::now() - t0).count() / 1e9;
+  };
+
+  RollingWindowHash rw(K);
+  unsigned long long acc = 0;
+  double g1 = stream([&](string_view c)
+                     { rw.feed(c, [&](uint64_t, auto h)
+                               { acc += h; }); });
+  GearChunker cdc;
+  size_t chunks = 0;
+  double g2 = stream([&](string_view c)
+                     { cdc.feed(c, [&](uint64_t)
+                                { ++chunks; }); });
+  RollingWindowHash rw2(K);
+  Winnower win(WIN);
+  size_t prints = 0;
+  double g3 = stream([&](string_view c)
+                     { rw2.feed(c, [&](uint64_t pos, auto h)
+                                { win.push(h, pos, [&](uint64_t, auto)
+                                           { ++prints; }); }); });
+  RollingWindowHash rw3(K);
+  BlockWinnower bwin(WIN);
+  size_t prints2 = 0;
+  double g4 = stream([&](string_view c)
+                     { rw3.feed(c, [&](uint64_t pos, auto h)
+                                { bwin.push(h, pos, [&](uint64_t, auto)
+                                            { ++prints2; }); }); });
+  cout << "RollingWindowHash   " << g1 << " GB/s  (acc=" << acc % 1000 << ")\n"
+       << "GearChunker         " << g2 << " GB/s  chunks=" << chunks << " avg=" << N / max<size_t>(chunks, 1)
+       << '\n'
+       << "hash + winnowing    " << g3 << " GB/s  fingerprints=" << prints << '\n'
+       << "hash + block winnow " << g4 << " GB/s  fingerprints=" << prints2 << '\n';
+}
+#endif
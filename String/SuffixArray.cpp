@@ -8,6 +8,7 @@
     - 部分文字列の辞書順比較      | O(1)  ※SA+RMQ
     - 単一パターン検索 (exists)   | O(M log N)
     - 出現区間列挙 (search)       | O(M log N)
+    - まとめて検索 lower_upper_batch | 同上  ※G 本を同時に進めて先読み
     - 最長重複部分列 (LR)         | O(N)  ※max LCP
     - 異なる部分文字列個数        | N(N+1)/2 − Σ LCP
     - 文字列集合 LCP クエリ       | O(1)  ※RMQ 前処理 O(N log N)
@@ -41,6 +42,7 @@
 
 #pragma once
 #include <bits/stdc++.h>
+#include "LCE.cpp"
 using namespace std;
 
 struct SuffixArray
@@ -59,40 +61,113 @@ struct SuffixArray
   template <class Seq>
   pair<int, int> lower_upper(const Seq &pat) const
   {
-    auto cmp = [&](const Seq &P, int sufPos)
+    return lower_upper(sa.data(), (int)sa.size(), _S, pat);
+  }
+
+  // sa の値を [0, N] に収める (N は空の接尾辞)。
+  //   mmap した未検査の sa (SuffixArrayView) が壊れていてもテキストの外を読まないため
+  static int clip(int pos, int N) { return (unsigned)pos <= (unsigned)N ? pos : N; }
+
+  // 外部の SA 配列 sa[0, N) とテキスト S に対する同じ探索 (mmap したビュー用)
+  template <class Seq>
+  static pair<int, int> lower_upper(const int *sa, int N, string_view S, const Seq &pat)
+  {
+    const int n = (int)pat.size();
+    auto _char = [&](int x)
+    { return (unsigned char)S[x]; };
+    // suffix sufPos と P の一致長 (高々 |P|)
+    auto match = [&](int sufPos)
+    { return lce(pat, 0, S, sufPos, min(n, N - sufPos)); };
+    // suffix の先頭 |P| 文字 < P
+    auto suf_less = [&](int sufPos, const Seq &P)
     {
-      int i = 0, n = (int)P.size(), N = (int)rank.size();
-      while (i < n && sufPos + i < N)
-      {
-        if (P[i] != _char(sufPos + i))
-          return P[i] < _char(sufPos + i);
-        ++i;
-      }
-      return i != n;
+      sufPos = clip(sufPos, N);
+      int i = match(sufPos);
+      if (i == n)
+        return false;
+      if (sufPos + i == N)
+        return true; // suffix が P の真の接頭辞
+      return _char(sufPos + i) < (unsigned char)P[i];
     };
-    int n = (int)sa.size();
-    int l = lower_bound(sa.begin(), sa.end(), pat, cmp) - sa.begin();
-    int r = upper_bound(sa.begin(), sa.end(), pat,
-                        [&](const Seq &P, int sufPos)
-                        { return !cmp(P, sufPos) && !_eq(P, sufPos); }) -
-            sa.begin();
+    // P < suffix の先頭 |P| 文字
+    auto pat_less = [&](const Seq &P, int sufPos)
+    {
+      sufPos = clip(sufPos, N);
+      int i = match(sufPos);
+      if (i == n || sufPos + i == N)
+        return false;
+      return (unsigned char)P[i] < _char(sufPos + i);
+    };
+    int l = lower_bound(sa, sa + N, pat, suf_less) - sa;
+    int r = upper_bound(sa, sa + N, pat, pat_less) - sa;
     return {l, r};
   }
 
-private:
-  /*------------ helpers ------------*/
-  inline char _char(int x) const { return _S[x]; }
-  bool _eq(const string &P, int suf) const
+  /*----------------------------------------------------------
+    まとめて検索 (group prefetching)
+      G 個のパターンの lower / upper (計 2G 本の二分探索) を同じ歩数で
+      同時に進める。1 歩ごとに「sa[mid] を先読み」→「テキストの
+      S[sa[mid]] を先読み」→「比較」の 3 巡に分け、依存するキャッシュ
+      ミス 2 回を 2G 本で重ねる。結果は pats と同じ順で lower_upper と一致。
+  ----------------------------------------------------------*/
+  template <class Seq>
+  vector<pair<int, int>> lower_upper_batch(const vector<Seq> &pats) const
   {
-    int n = (int)P.size(), N = (int)_S.size();
-    if (suf + n > N)
-      return false;
-    for (int i = 0; i < n; ++i)
-      if (P[i] != _S[suf + i])
-        return false;
-    return true;
+    return lower_upper_batch(sa.data(), (int)sa.size(), _S, pats);
   }
 
+  template <class Seq>
+  static vector<pair<int, int>> lower_upper_batch(const int *sa, int N, string_view S, const vector<Seq> &pats)
+  {
+    constexpr int G = 16;
+    const int q = (int)pats.size();
+    vector<pair<int, int>> res(q, {0, 0});
+    if (N == 0)
+      return res;
+    // 本 k : パターン g0 + k/2 の lower (k 偶) / upper (k 奇)
+    //   右へ進む条件 : lower は「suffix の先頭 |P| 文字 < P」、upper は「<= P」
+    auto go_right = [&](const Seq &P, bool upper, int pos)
+    {
+      pos = clip(pos, N);
+      const int n = (int)P.size();
+      const int i = lce(P, 0, S, pos, min(n, N - pos));
+      if (i == n)
+        return upper;
+      if (pos + i == N)
+        return true; // suffix が P の真の接頭辞
+      return (unsigned char)S[pos + i] < (unsigned char)P[i];
+    };
+    int base[2 * G];
+    for (int g0 = 0; g0 < q; g0 += G)
+    {
+      const int m = 2 * min(G, q - g0);
+      fill(base, base + m, 0);
+      for (int len = N; len > 1;)
+      {
+        const int half = len / 2;
+        for (int k = 0; k < m; ++k)
+          __builtin_prefetch(sa + base[k] + half);
+        for (int k = 0; k < m; ++k)
+          __builtin_prefetch(S.data() + sa[base[k] + half]);
+        for (int k = 0; k < m; ++k)
+          if (go_right(pats[g0 + k / 2], k & 1, sa[base[k] + half]))
+            base[k] += half;
+        len -= half;
+      }
+      for (int k = 0; k < m; ++k)
+        __builtin_prefetch(S.data() + sa[base[k]]);
+      for (int k = 0; k < m; k += 2)
+        res[g0 + k / 2] = {base[k] + go_right(pats[g0 + k / 2], false, sa[base[k]]),
+                           base[k + 1] + go_right(pats[g0 + k / 2], true, sa[base[k + 1]])};
+    }
+    return res;
+  }
+
+  const string &text() const { return _S; }
+
+private:
+  /*------------ helpers ------------*/
+  inline unsigned char _char(int x) const { return _S[x]; } // build_sa と同じ unsigned 順
   string _S;
 
   template <class Seq>
@@ -139,8 +214,7 @@ private:
       if (r == 0)
         continue;
       int j = sa[r - 1];
-      while (i + h < n && j + h < n && s[i + h] == s[j + h])
-        ++h;
+      h += lce(s, i + h, s, j + h, n - max(i, j) - h);
       lcp[r - 1] = h;
       if (h)
         --h;
@@ -192,7 +266,7 @@ inline int lcp_suffix(const SuffixArray &sa,
                       int i, int j)
 {
   if (i == j)
-    return (int)sa._S.size() - i; // 同じ接尾辞
+    return (int)sa.sa.size() - i; // 同じ接尾辞
   int ri = sa.rank[i], rj = sa.rank[j];
   if (ri > rj)
     std::swap(ri, rj);
@@ -246,6 +320,8 @@ inline std::pair<int, int> longest_repeated_substr_sa(const SuffixArray &sa)
   return {best, idx};
 }
 
+/*--------------------------- demo ---------------------------*/
+#ifndef SUFFIXARRAY_NO_DEMO
 int main()
 {
   ios::sync_with_stdio(false);
@@ -263,3 +339,4 @@ int main()
     }
   cout << "Longest repeat: " << S.substr(idx, best) << "\n";
 }
+#endif
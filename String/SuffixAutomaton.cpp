@@ -0,0 +1,405 @@
+/************************************************************
+  Suffix Automaton  –  末尾追加しながら全部分文字列を受理する最小 DFA
+  ----------------------------------------------------------
+  ◆ できること (N = 追加済み長, σ = 状態の出次数)  | 時間計算量
+    - 1 文字追加 append(c) / append_all(s)        | 償却 O(1) ※遷移探索 O(log σ)
+    - 異なる部分文字列の個数 distinct()             | O(1)  ※追加ごとに更新
+    - 部分文字列判定 contains(P)                   | O(|P|)
+    - 出現回数 count_occurrences(P)                | O(|P|)  ※追加後の初回だけ +O(N)
+    - T との最長共通部分文字列 longest_common(T)   | O(|T|)
+      返り値 {長さ, S 側の開始, T 側の開始}。longest_common_substr (RollingHash)
+      と同じく T 側の開始が最小のもの (S 側はその中で最小)。無ければ {0, -1, -1}
+
+  ◆ 実装方針
+    * 状態 0 が初期状態。len / link / firstpos / occ を状態ごとの配列で持つ。
+    * 遷移は map を使わず、1 本の辺プール edges 上の「文字順に並べた小配列」。
+      あふれたら 2 倍の塊へ移し、空いた塊はサイズ別の空きリストで再利用する。
+      8 本以下は線形探索、それより多ければ二分探索。
+    * 要素が 1 byte の型 (char など) では、出次数が 16 を超えた状態だけ
+      256 幅の直接表 dense に移す (根の近くの状態がこれになる)。
+    * 出現回数は「複製でない状態に 1」を link 木で下から足した値。追加のたびに
+      作り直すと O(N) なので、追加後に初めて問い合わせたとき len の計数ソートで
+      まとめて集計する。
+    * PalindromicTree と同じく要素型 T は < と == で比べられれば何でもよい。
+
+  ◆ 典型用法
+      SuffixAutomaton<char> sam;
+      for (auto &chunk : stream) {
+          sam.append_all(chunk);
+          if (sam.contains("ERROR 42")) ...
+          long long kinds = sam.distinct();
+      }
+      int k = sam.count_occurrences("timeout");
+      auto [L, is, it] = sam.longest_common(T);   // S.substr(is, L) == T.substr(it, L)
+************************************************************/
+
+#pragma once
+#include <bits/stdc++.h>
+using namespace std;
+
+template <class T = char>
+struct SuffixAutomaton
+{
+  static constexpr bool BYTE = is_integral_v<T> && sizeof(T) == 1;
+  static constexpr uint32_t SMALL = 16, DENSE = UINT32_MAX; // cap == DENSE : 直接表
+  struct Edge
+  {
+    T c;
+    int to;
+  };
+
+  vector<int> len, link, firstpos; // firstpos : 最初の出現の終端位置
+  vector<char> is_clone;
+  vector<uint32_t> off, deg, cap; // 辺の塊 edges[off, off + cap) (dense なら表の番号)
+  vector<Edge> edges;
+  vector<int> dense; // 256 本ずつ (-1 = 遷移なし)
+  vector<vector<uint32_t>> free_blk; // free_blk[k] : 容量 2^k の空き塊
+  int last = 0, n = 0;
+  long long kinds = 0;
+
+  SuffixAutomaton() { clear(); }
+
+  void clear()
+  {
+    len = {0}, link = {-1}, firstpos = {-1};
+    is_clone = {0};
+    off = {0}, deg = {0}, cap = {0};
+    edges.clear();
+    dense.clear();
+    free_blk.assign(33, {});
+    occ_.clear();
+    last = n = 0;
+    kinds = 0;
+  }
+
+  void reserve(int m)
+  {
+    for (auto *v : {&len, &link, &firstpos})
+      v->reserve(2 * m + 1);
+    for (auto *v : {&off, &deg, &cap})
+      v->reserve(2 * m + 1);
+    is_clone.reserve(2 * m + 1);
+    edges.reserve(3 * m);
+  }
+
+  int size() const { return n; }
+  int states() const { return (int)len.size(); }
+  long long distinct() const { return kinds; } // 空文字列は数えない
+
+  // 末尾に c を追加
+  void append(const T &c)
+  {
+    const int cur = new_state(len[last] + 1, 0);
+    firstpos[cur] = n++;
+    int p = last;
+    while (p != -1 && get(p, c) == -1)
+    {
+      add(p, c, cur);
+      p = link[p];
+    }
+    if (p == -1)
+      link[cur] = 0;
+    else
+    {
+      const int q = get(p, c);
+      if (len[p] + 1 == len[q])
+        link[cur] = q;
+      else
+      { // q を分割 : 長さ len[p]+1 までの部分を複製 cl に
+        const int cl = new_state(len[p] + 1, 1);
+        link[cl] = link[q];
+        firstpos[cl] = firstpos[q];
+        copy_edges(q, cl);
+        for (; p != -1 && get(p, c) == q; p = link[p])
+          set(p, c, cl);
+        link[q] = link[cur] = cl;
+      }
+    }
+    last = cur;
+    kinds += len[cur] - len[link[cur]];
+    occ_.clear(); // 出現回数は次に問い合わせたとき作り直す
+  }
+
+  template <class Seq>
+  void append_all(const Seq &s)
+  {
+    for (const auto &c : s)
+      append(c);
+  }
+
+  // 状態 v から c で遷移 (無ければ -1)
+  int get(int v, const T &c) const
+  {
+    if constexpr (BYTE)
+      if (cap[v] == DENSE)
+        return dense[(size_t)off[v] * 256 + (unsigned char)c];
+    const Edge *e = edges.data() + off[v];
+    const int d = (int)deg[v];
+    if (d <= 8)
+    {
+      for (int i = 0; i < d; ++i)
+        if (!(e[i].c < c))
+          return e[i].c == c ? e[i].to : -1;
+      return -1;
+    }
+    const Edge *it = lower_bound(e, e + d, c, [](const Edge &x, const T &y)
+                                 { return x.c < y; });
+    return it != e + d && it->c == c ? it->to : -1;
+  }
+
+  // P を読み終えた状態 (途中で遷移が無ければ -1)
+  template <class Seq>
+  int walk(const Seq &P) const
+  {
+    int v = 0;
+    for (const auto &c : P)
+      if ((v = get(v, c)) == -1)
+        return -1;
+    return v;
+  }
+
+  template <class Seq>
+  bool contains(const Seq &P) const { return walk(P) != -1; }
+
+  // P の出現回数 (空なら N。SuffixArray::lower_upper の r - l と同じ)
+  template <class Seq>
+  int count_occurrences(const Seq &P)
+  {
+    const int v = walk(P);
+    if (v == -1)
+      return 0;
+    if (v == 0)
+      return n;
+    if (occ_.empty())
+      build_occ();
+    return occ_[v];
+  }
+
+  // {長さ, S 側の開始, T 側の開始} (無ければ {0, -1, -1})
+  template <class Seq>
+  tuple<int, int, int> longest_common(const Seq &t) const
+  {
+    int v = 0, l = 0, best = 0, bv = 0, bend = -1;
+    for (int i = 0; i < (int)t.size(); ++i)
+    {
+      while (v != 0 && get(v, t[i]) == -1)
+        l = len[v = link[v]];
+      if (int w = get(v, t[i]); w != -1)
+        v = w, ++l;
+      if (l > best)
+        best = l, bv = v, bend = i;
+    }
+    if (best == 0)
+      return {0, -1, -1};
+    return {best, firstpos[bv] - best + 1, bend - best + 1};
+  }
+
+  size_t memory_bytes() const
+  {
+    return len.capacity() * (4 * 3 + 1 + 4 * 3) + edges.capacity() * sizeof(Edge) + dense.capacity() * 4 +
+           occ_.capacity() * 4;
+  }
+
+private:
+  vector<int> occ_; // 出現回数 (空なら未集計)
+
+  int new_state(int l, char clone)
+  {
+    len.push_back(l);
+    link.push_back(-1);
+    firstpos.push_back(-1);
+    is_clone.push_back(clone);
+    off.push_back(0);
+    deg.push_back(0);
+    cap.push_back(0);
+    return (int)len.size() - 1;
+  }
+
+  uint32_t alloc(uint32_t c)
+  {
+    auto &fl = free_blk[__builtin_ctz(c)];
+    if (!fl.empty())
+    {
+      uint32_t b = fl.back();
+      fl.pop_back();
+      return b;
+    }
+    edges.resize(edges.size() + c);
+    return (uint32_t)(edges.size() - c);
+  }
+
+  void release(int v)
+  {
+    if (cap[v] != 0 && cap[v] != DENSE)
+      free_blk[__builtin_ctz(cap[v])].push_back(off[v]);
+  }
+
+  // 遷移の無い c を追加
+  void add(int v, const T &c, int to)
+  {
+    if constexpr (BYTE)
+    {
+      if (cap[v] == DENSE)
+      {
+        dense[(size_t)off[v] * 256 + (unsigned char)c] = to;
+        ++deg[v];
+        return;
+      }
+      if (deg[v] == SMALL)
+      { // 直接表へ移す
+        const uint32_t b = (uint32_t)(dense.size() / 256);
+        dense.resize(dense.size() + 256, -1);
+        for (uint32_t i = 0; i < deg[v]; ++i)
+          dense[(size_t)b * 256 + (unsigned char)edges[off[v] + i].c] = edges[off[v] + i].to;
+        release(v);
+        off[v] = b, cap[v] = DENSE;
+        add(v, c, to);
+        return;
+      }
+    }
+    if (deg[v] == cap[v])
+    { // 2 倍の塊へ
+      const uint32_t nc = max<uint32_t>(1, 2 * cap[v]), b = alloc(nc);
+      copy_n(edges.begin() + off[v], deg[v], edges.begin() + b);
+      release(v);
+      off[v] = b, cap[v] = nc;
+    }
+    Edge *e = edges.data() + off[v];
+    int i = (int)deg[v]++;
+    for (; i > 0 && c < e[i - 1].c; --i)
+      e[i] = e[i - 1];
+    e[i] = {c, to};
+  }
+
+  // 既存の遷移 c の行き先を to に
+  void set(int v, const T &c, int to)
+  {
+    if constexpr (BYTE)
+      if (cap[v] == DENSE)
+      {
+        dense[(size_t)off[v] * 256 + (unsigned char)c] = to;
+        return;
+      }
+    Edge *e = edges.data() + off[v];
+    Edge *it = lower_bound(e, e + deg[v], c, [](const Edge &x, const T &y)
+                           { return x.c < y; });
+    it->to = to;
+  }
+
+  void copy_edges(int from, int to)
+  {
+    deg[to] = deg[from];
+    if (cap[from] == DENSE)
+    {
+      const uint32_t b = (uint32_t)(dense.size() / 256);
+      dense.resize(dense.size() + 256);
+      copy_n(dense.begin() + (size_t)off[from] * 256, 256, dense.begin() + (size_t)b * 256);
+      off[to] = b, cap[to] = DENSE;
+    }
+    else if (cap[from])
+    {
+      const uint32_t b = alloc(cap[from]); // alloc で edges が伸びうるので先に確保
+      copy_n(edges.begin() + off[from], deg[from], edges.begin() + b);
+      off[to] = b, cap[to] = cap[from];
+    }
+  }
+
+  // 複製でない状態に 1 を置き、len の降順に link 先へ足す
+  void build_occ()
+  {
+    const int m = (int)len.size();
+    vector<int> bucket(n + 2, 0), order(m);
+    for (int v = 0; v < m; ++v)
+      ++bucket[len[v]];
+    for (int l = 1; l <= n; ++l)
+      bucket[l] += bucket[l - 1];
+    for (int v = m - 1; v >= 0; --v)
+      order[--bucket[len[v]]] = v;
+    occ_.assign(m, 0);
+    for (int v = 1; v < m; ++v)
+      occ_[v] = !is_clone[v];
+    for (int k = m - 1; k > 0; --k)
+      occ_[link[order[k]]] += occ_[order[k]];
+  }
+};
+
+/*--------------------- benchmark / demo ---------------------*/
+// ログが伸びていく状況 : チャンクを追加するたびに出現回数を問い合わせる
+//   (a) SuffixAutomaton に追記
+//   (b) そこまでのテキストで SuffixArray を作り直して lower_upper
+// 最後に longest_common を longest_common_substr (RollingHash) と比較
+#ifndef SUFFIXAUTOMATON_NO_DEMO
+#define SUFFIXARRAY_NO_DEMO
+#define ROLLINGHASH_NO_DEMO
+#include "RollingHash.cpp"
+#include "SuffixArray.cpp"
+
+int main(int argc, char **argv)
+{
+  ios::sync_with_stdio(false);
+  cin.tie(nullptr);
+
+  const int M = argc >= 2 ? atoi(argv[1]) : 1000000, CH = 8, Q = 1000;
+  mt19937 rng(1);
+  // ログ風のテキスト : 限られた語彙の行 + 数値
+  const vector<string> vocab = {"GET ", "POST ", "/api/v1/", "user", "order", "ERROR ", "timeout ",
+                                "ok ", "200 ", "404 ", "500 ", "ms\n"};
+  string S;
+  while ((int)S.size() < M)
+  {
+    S += vocab[rng() % vocab.size()];
+    if (rng() % 3 == 0)
+      S += to_string(rng() % 1000) + ' ';
+  }
+  S.resize(M);
+
+  using clk = chrono::steady_clock;
+  auto ms = [](auto d)
+  { return chrono::duration<double, milli>(d).count(); };
+  SuffixAutomaton<char> sam;
+  sam.reserve(M);
+  double t_sam = 0, t_sa = 0;
+  bool same = true;
+  for (int k = 1; k <= CH; ++k)
+  {
+    const int lo = (int)((long long)M * (k - 1) / CH), hi = (int)((long long)M * k / CH);
+    vector<string> ps(Q);
+    for (auto &p : ps)
+    {
+      const int st = rng() % (hi - 16);
+      p = S.substr(st, 2 + rng() % 14);
+    }
+    auto t0 = clk::now();
+    sam.append_all(string_view(S).substr(lo, hi - lo));
+    vector<int> a(Q);
+    for (int i = 0; i < Q; ++i)
+      a[i] = sam.count_occurrences(ps[i]);
+    auto t1 = clk::now();
+    SuffixArray sa(S.substr(0, hi));
+    for (int i = 0; i < Q; ++i)
+    {
+      auto [l, r] = sa.lower_upper(ps[i]);
+      same &= a[i] == r - l;
+    }
+    auto t2 = clk::now();
+    t_sam += ms(t1 - t0), t_sa += ms(t2 - t1);
+  }
+  cout << "|S|=" << M << " states=" << sam.states() << " (" << sam.memory_bytes() / 1048576.0 << " MiB)"
+       << " distinct=" << sam.distinct() << '\n'
+       << CH << " chunks x " << Q << " count_occurrences\n"
+       << "  SuffixAutomaton append+query " << t_sam << " ms\n"
+       << "  SuffixArray rebuild+query    " << t_sa << " ms  " << (same ? "same" : "MISMATCH") << '\n';
+
+  // 最長共通部分文字列
+  string T = S.substr(M / 3, M / 4);
+  for (int i = 0; i < (int)T.size(); i += 97)
+    T[i] = '#';
+  auto u0 = clk::now();
+  auto x = sam.longest_common(T);
+  auto u1 = clk::now();
+  auto y = longest_common_substr(S, T);
+  auto u2 = clk::now();
+  cout << "longest_common |T|=" << T.size() << "  SuffixAutomaton " << ms(u1 - u0) << " ms  RollingHash "
+       << ms(u2 - u1) << " ms  len=" << get<0>(x) << ' ' << (x == y ? "same" : "MISMATCH") << '\n';
+}
+#endif
@@ -3,7 +3,7 @@
   ----------------------------------------------------------
   ◆ できること                      | 時間計算量
     - Z 配列一括構築               | O(N)
-    - 単一パターン検索 (exists)    | O(N + M)   ※ concat 方式
+    - 単一パターン検索 (exists)    | O(N + M)   ※ 連結せず Z-box で照合
     - 出現位置列挙 (search)        | O(N + M)
     - 全 border 列挙              | O(N)
     - 文字列の最小周期判定         | O(N)
@@ -23,6 +23,7 @@
 
 #pragma once
 #include <bits/stdc++.h>
+#include "LCE.cpp"
 using namespace std;
 
 /*------------------------------------------------------------
@@ -41,8 +42,7 @@ vector<int> z_algorithm(const string &s)
   {
     if (i <= r)
       z[i] = min(r - i + 1, z[i - l]);
-    while (i + z[i] < n && s[z[i]] == s[i + z[i]])
-      ++z[i];
+    z[i] += lce(s, z[i], s, i + z[i], n - i - z[i]);
     if (i + z[i] - 1 > r)
     {
       l = i;
@@ -53,17 +53,29 @@ vector<int> z_algorithm(const string &s)
 }
 
 // pat 検索。返り値: 出現開始 idx (0-indexed)
+//   pat の Z 配列だけを作り、text 側は Z-box を使って伸ばす
+//   (pat + '$' + text を作らないので任意 byte 列で使え、コピーも無い)
 vector<int> z_search(const string &text, const string &pat)
 {
   if (pat.empty())
     return {0};
-  string concat = pat + '$' + text; // '$' は非出現文字
-  auto z = z_algorithm(concat);
+  auto z = z_algorithm(pat);
   vector<int> res;
-  int m = (int)pat.size();
-  for (int i = m + 1; i < (int)z.size(); ++i)
-    if (z[i] >= m)
-      res.push_back(i - m - 1);
+  int n = (int)text.size(), m = (int)pat.size();
+  for (int i = 0, l = 0, r = -1; i < n; ++i)
+  {
+    // text[l..r] == pat[0..r-l] が成り立つ区間を再利用
+    int k = (i <= r) ? min(r - i + 1, z[i - l]) : 0;
+    while (k < m && i + k < n && pat[k] == text[i + k])
+      ++k;
+    if (k == m)
+      res.push_back(i);
+    if (i + k - 1 > r)
+    {
+      l = i;
+      r = i + k - 1;
+    }
+  }
   return res;
 }
 